@@ -38,8 +38,9 @@ namespace ENV {
         bool operator == (const NodeData& other) const { return data0 == other.data0 && data1 == other.data1 && data2 == other.data2; }
     };
 
-    extern vec<NodeData>       nodes;
-    extern Map<NodeData, int>  uniqueness_table;
+    // Each thread has its own environment (see 'import()').
+    extern thread_local vec<NodeData>       nodes;
+    extern thread_local Map<NodeData, int>  uniqueness_table;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -326,7 +327,7 @@ macro Formula ITE(Formula c, Formula t, Formula f)
 bool eval(Formula f, AMap<char>& values);
 
 namespace FEnv {
-    extern vec<int> stack;
+    extern thread_local vec<int> stack;
     macro void clear() { nodes.clear(); uniqueness_table.clear(); }
     macro void push()  { stack.push(nodes.size()); }
     macro void pop()   {
@@ -336,6 +337,8 @@ namespace FEnv {
     macro void keep()  { stack.pop(); }
     macro int  topSize() {
         return (stack.size() == 0) ? nodes.size() : nodes.size() - stack.last(); }
+
+    Formula import(const vec<NodeData>& from, Formula f);
 }
 
 
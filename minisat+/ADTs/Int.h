@@ -84,34 +84,85 @@ public:
 //=================================================================================================
 
 
-#define A1 assert(!small());
-#define A2 assert(!small()); assert(!other.small());
+#define A1 assert(!inf());
+#define A2 assert(!inf()); assert(!other.inf());
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#define Int_MIN Int((mpz_t*)-1)
-#define Int_MAX Int((mpz_t*)1)
+// Numbers are stored inline as '2*value+1' in the pointer when '|value| <= Int_Small__' (so sums
+// and products of two of them can be computed in 'int64'), larger numbers are promoted to GMP.
+// The special values '-oo' and '+oo' are the inline values '-Int_Inf__' and 'Int_Inf__'.
+#define Int_Small__ ((intp)1 << (sizeof(intp)*8 - 3))
+#define Int_Inf__   (Int_Small__ * 2 - 1)
+
+#define Int_MIN Int((mpz_t*)(-Int_Inf__ * 2 + 1))
+#define Int_MAX Int((mpz_t*)( Int_Inf__ * 2 + 1))
 
 
 class Int {
-    mpz_t*  data;       // This pointer is meant to contain small integers when bit 0 is set (for efficiency). 
-                        // Currently the only small integers used are the special values 'Int_MIN' and 'Int_MAX'.
+    mpz_t*  data;       // This pointer contains small integers when bit 0 is set (see above). Numbers that fit
+                        // inline are never stored by GMP, so each number has exactly one representation.
     bool small() const { return ((intp)data & 1) != 0; }
+    intp value() const { return (intp)data >> 1; }      // (only for small)
+    bool inf  () const { return small() && (value() > Int_Small__ || value() < -Int_Small__); }
+
+    static mpz_t* alloc() {
+        mpz_t* d = xmalloc<mpz_t>(1); assert(((intp)d & 1) == 0);
+        mpz_init(*d);
+        return d; }
+
+    void set(int64 x) {     // ('data' must not hold a GMP number)
+        if (x >= -(int64)Int_Small__ && x <= (int64)Int_Small__)
+            data = (mpz_t*)(intp)(x * 2 + 1);
+        else if (x == (long)x){
+            data = alloc();
+            mpz_set_si(*data, (long)x);
+        }else{     // ('long' may be only 32 bits)
+            uint64 u = (x < 0) ? -(uint64)x : (uint64)x;
+            data = alloc();
+            mpz_import(*data, 1, 1, sizeof(u), 0, 0, &u);
+            if (x < 0) mpz_neg(*data, *data); }
+    }
+
+    void normalize() {      // Move a GMP number that fits inline back inline.
+        if (!small() && mpz_fits_slong_p(*data)){
+            long x = mpz_get_si(*data);
+            if (x >= -Int_Small__ && x <= Int_Small__){
+                mpz_clear(*data);
+                xfree(data);
+                data = (mpz_t*)(intp)(x * 2 + 1); } }
+    }
+
+    // Operand for GMP: the number itself, or 'tmp' initialized to it if it is inline.
+    mpz_srcptr big(mpz_t tmp) const {
+        if (!small()) return *data;
+        mpz_init_set_si(tmp, (long)value());
+        return tmp; }
+
+    typedef void (*Op)(mpz_ptr, mpz_srcptr, mpz_srcptr);
+    static Int big(Op op, const Int& x, const Int& y) {
+        mpz_t tx, ty;
+        Int   ret(alloc());
+        op(*ret.data, x.big(tx), y.big(ty));
+        if (x.small()) mpz_clear(tx);
+        if (y.small()) mpz_clear(ty);
+        ret.normalize();
+        return ret; }
+
+    static Int mulSmall(int64 x, int64 y) {
+        int64 ret;
+        if (__builtin_mul_overflow(x, y, &ret))
+            return big(mpz_mul, Int(x), Int(y));
+        return Int(ret); }
 
 public:
     // Constructors/Destructor (+assignment operator)
     //
     Int(mpz_t* d) : data(d) {}      // Low-level constructor -- don't use!
 
-    Int() {
-        data = xmalloc<mpz_t>(1); assert(((intp)data & 1) == 0);
-        mpz_init(*data);
-    }
-
-    Int(int x) {
-        data = xmalloc<mpz_t>(1); assert(((intp)data & 1) == 0);
-        mpz_init_set_si(*data, x);
-    }
+    Int()        { set(0); }
+    Int(int   x) { set(x); }
+    Int(int64 x) { set(x); }
 
     Int(const Int& src) {
         if (src.small())
@@ -149,6 +200,7 @@ public:
 
     // -- Comparison (supports infinity)
     //    '+oo' and '-oo' are treated as two unique points beyond the integers. For instanse '+oo' is not < than itself, but <= than itself.
+    //    A GMP number is larger in magnitude than any finite inline number.
     bool operator == (const Int& other) const {
         if (small())
             return other.small() ? (data == other.data) : false;
@@ -158,16 +210,18 @@ public:
 
     bool operator <  (const Int& other) const {
         if (small()){
-            if (data == Int_MIN.data)
-                return (!other.small() || other.data != Int_MIN.data);
-            else{ assert(data == Int_MAX.data);
-                return false; }
+            if (other.small())
+                return value() < other.value();
+            else if (inf())
+                return value() < 0;
+            else
+                return mpz_sgn(*other.data) > 0;
         }else{
             if (other.small()){
-                if (other.data == Int_MIN.data)
-                    return false;
-                else{ assert(other.data == Int_MAX.data);
-                    return true; }
+                if (other.inf())
+                    return other.value() > 0;
+                else
+                    return mpz_sgn(*data) < 0;
             }else
                 return mpz_cmp(*data, *other.data) < 0;
         }
@@ -180,49 +234,58 @@ public:
 
 
     // -- Arithmetic (not allowed on infinity except for unary '-')
-    Int  operator + (const Int& other) const {A2  Int ret; mpz_add   (*ret.data, *data, *other.data); return ret; }
-    Int  operator - (const Int& other) const {A2  Int ret; mpz_sub   (*ret.data, *data, *other.data); return ret; }
-    Int  operator * (const Int& other) const {A2  Int ret; mpz_mul   (*ret.data, *data, *other.data); return ret; }
-    Int  operator / (const Int& other) const {A2  Int ret; mpz_tdiv_q(*ret.data, *data, *other.data); return ret; }
-    Int  operator % (const Int& other) const {A2  Int ret; mpz_tdiv_r(*ret.data, *data, *other.data); return ret; }
-
-    Int& operator += (const Int& other) {A2  mpz_add   (*data, *data, *other.data); return *this; }
-    Int& operator -= (const Int& other) {A2  mpz_sub   (*data, *data, *other.data); return *this; }
-    Int& operator *= (const Int& other) {A2  mpz_mul   (*data, *data, *other.data); return *this; }
-    Int& operator /= (const Int& other) {A2  mpz_tdiv_q(*data, *data, *other.data); return *this; }
-    Int& operator %= (const Int& other) {A2  mpz_tdiv_r(*data, *data, *other.data); return *this; }
+    Int  operator + (const Int& other) const {A2  return (small() && other.small()) ? Int((int64)value() + other.value()) : big(mpz_add, *this, other); }
+    Int  operator - (const Int& other) const {A2  return (small() && other.small()) ? Int((int64)value() - other.value()) : big(mpz_sub, *this, other); }
+    Int  operator * (const Int& other) const {A2  return (small() && other.small()) ? mulSmall(value(), other.value())    : big(mpz_mul, *this, other); }
+    Int  operator / (const Int& other) const {A2  return (small() && other.small()) ? Int((int64)value() / other.value()) : big(mpz_tdiv_q, *this, other); }
+    Int  operator % (const Int& other) const {A2  return (small() && other.small()) ? Int((int64)value() % other.value()) : big(mpz_tdiv_r, *this, other); }
+
+    Int& operator += (const Int& other) { return *this = *this + other; }
+    Int& operator -= (const Int& other) { return *this = *this - other; }
+    Int& operator *= (const Int& other) { return *this = *this * other; }
+    Int& operator /= (const Int& other) { return *this = *this / other; }
+    Int& operator %= (const Int& other) { return *this = *this % other; }
     Int& operator ++ () { return *this += Int(1); }
     Int& operator -- () { return *this -= Int(1); }
 
     Int operator - () const {
         if (small())
-            return Int((mpz_t*)(-(intp)data));
+            return Int((mpz_t*)(intp)(-value() * 2 + 1));
         else{
-            Int ret; mpz_neg(*ret.data, *data); return ret; }
+            Int ret(alloc()); mpz_neg(*ret.data, *data); return ret; }
     }
 
     // -- Bit operators (incomplete; we don't need more at the moment)
-    Int  operator & (const Int& other) const {A2  Int ret; mpz_and(*ret.data, *data, *other.data); return ret; }
-    Int& operator >>= (int n) {A1  mpz_fdiv_q_2exp(*data, *data, n); return *this; }
+    Int  operator & (const Int& other) const {A2  return (small() && other.small()) ? Int((int64)(value() & other.value())) : big(mpz_and, *this, other); }
+    Int& operator >>= (int n) {A1
+        if (small())
+            data = (mpz_t*)(intp)((value() >> min(n, (int)sizeof(intp)*8 - 1)) * 2 + 1);
+        else{
+            mpz_fdiv_q_2exp(*data, *data, n);
+            normalize(); }
+        return *this; }
 
     // Methods:
     //
     friend char* toString(Int num) {
         if      (num == Int_MIN) return xstrdup("-oo");
         else if (num == Int_MAX) return xstrdup("+oo");
-        assert(!num.small());
+        else if (num.small()){
+            char buf[32]; sprintf(buf, "%lld", (int64)num.value()); return xstrdup(buf); }
         char* tmp = xmalloc<char>(mpz_sizeinbase (*num.data, 10) + 2);
         mpz_get_str(tmp, 10, *num.data);
         return tmp;
     }
 
     friend int toint (Int num) {
-        if (num.small() || !mpz_fits_sint_p(*num.data))
+        if (num.inf() || (num.small() ? (num.value() < INT_MIN || num.value() > INT_MAX) : !mpz_fits_sint_p(*num.data)))
             throw Exception_IntOverflow(xstrdup("toint"));
-        return (int)mpz_get_si(*num.data);
+        return num.small() ? (int)num.value() : (int)mpz_get_si(*num.data);
     }
 
     uint hash() const {   // primitive hash function -- not good with bit-shifts
+        if (small())
+            return (uint)value() ^ (uint)((int64)value() >> 32);
         mp_size_t size = mpz_size(*data);
         mp_limb_t val = 0;
         for (mp_size_t i = 0; i < size; i++){
@@ -9,11 +9,15 @@
 
 int  estimatedAdderCost(const Linear& c);
 void oddEvenSort(vec<Formula>& fs);
+void oddEvenSelect(vec<Formula>& fs, int k);
+void totalizer(vec<Formula>& fs, int k);
 void rippleAdder(const vec<Formula>& xs, const vec<Formula>& ys, vec<Formula>& out);
 void addPb(const vec<Formula>& ps, const vec<Int>& Cs_, vec<Formula>& out, int bits);
+void addPbDadda(const vec<Formula>& ps, const vec<Int>& Cs_, vec<Formula>& out, int bits);
 
-void clausify(Solver& s, const vec<Formula>& fs, vec<Lit>& out);
+void clausify(Solver& s, const vec<Formula>& fs, vec<Lit>& out, int group = 0);
 void clausify(Solver& s, const vec<Formula>& fs);
+void clausifyCount(const vec<Formula>& fs, int& n_vars, int& n_clauses);
 
 
 //=================================================================================================
@@ -7,13 +7,14 @@
 
 
 enum SolverT  { st_MiniSat, st_SatELite };
-enum ConvertT { ct_Sorters, ct_Adders, ct_BDDs, ct_Mixed, ct_Undef };
+enum ConvertT { ct_Sorters, ct_Selectors, ct_Totalizers, ct_Adders, ct_Dadda, ct_BDDs, ct_Mixed, ct_Undef };
 enum Command  { cmd_Minimize, cmd_FirstSolution, cmd_AllSolutions };
 
 // -- output options:
 extern bool     opt_satlive;
 extern bool     opt_ansi;
 extern char*    opt_cnf;
+extern char*    opt_bcnf;
 extern int      opt_verbosity;
 extern bool     opt_try;
 
@@ -22,6 +23,7 @@ extern SolverT  opt_solver;
 extern ConvertT opt_convert;
 extern ConvertT opt_convert_goal;
 extern bool     opt_convert_weak;
+extern bool     opt_share_sums;
 extern double   opt_bdd_thres;
 extern double   opt_sort_thres;
 extern double   opt_goal_bias;
@@ -29,6 +31,8 @@ extern Int      opt_goal;
 extern Command  opt_command;
 extern bool     opt_branch_pbvars;
 extern int      opt_polarity_sug;
+extern int      opt_threads;
+extern int      opt_tune;
 
 // -- files:
 extern char*    opt_input;
@@ -37,6 +41,7 @@ extern char*    opt_result;
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 void reportf(const char* format, ...);      // 'printf()' replacer -- will put "c " first at each line if 'opt_satlive' is TRUE.
+extern thread_local vec<char>* report_buffer;  // If set, 'reportf()' appends the text to it instead of printing.
 
 
 //=================================================================================================
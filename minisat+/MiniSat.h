@@ -192,6 +192,8 @@ public:
     bool    addClause(const vec<Lit>& ps) { if (ok){ Clause* c; ok = newClause(ps, false, c); if (c != NULL) clauses.push(c); } return ok; }
     // -- debug:
     void    exportClauses(cchar* filename, vec<cchar*>& index2name, int n_splits);
+    void    exportClausesBinary(cchar* filename, vec<cchar*>& index2name, int n_splits);
+    void    exportClauses(vec<Lit>& out);
 
     // Solving:
     //
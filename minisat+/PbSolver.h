@@ -55,18 +55,23 @@ protected:
 
     int                 propQ_head;     // Head of propagation queue (index into 'trail').
 
+    vec<int>            group_begin;    // Group -> index of its first constraint in 'constrs'. Empty unless groups are used.
+    vec<vec<Lit> >      group_clauses;  // Group -> its clauses, each one terminated by 'lit_Undef'.
+
 
     // Main internal methods:
     //
     bool    propagate(Linear& c);
     void    propagate();
-    bool    addUnit  (Lit p) { return sat_solver.addUnit(p); }
+    bool    addUnit  (Lit p) { if (group_begin.size() == 0) return sat_solver.addUnit(p); group_clauses.last().push(p); group_clauses.last().push(lit_Undef); return true; }
     bool    normalizePb(vec<Lit>& ps, vec<Int>& Cs, Int& C);
     void    storePb    (const vec<Lit>& ps, const vec<Int>& Cs, Int lo, Int hi);
     void    setupOccurs();   // Called on demand from 'propagate()'.
     void    findIntervals();
     bool    rewriteAlmostClauses();
     bool    convertPbs(bool first_call);   // Called from 'solve()' to convert PB constraints to clauses.
+    void    convertGroups();                // Called from 'solve()' instead of 'convertPbs()' if groups are used.
+    void    exportGroups(cchar* filename, bool binary);
 
 public:
     PbSolver()  : sat_solver(opt_solver == st_MiniSat)
@@ -108,6 +113,7 @@ public:
     void    allocConstrs(int n_vars, int n_constrs);
     void    addGoal     (const vec<Lit>& ps, const vec<Int>& Cs);
     bool    addConstr   (const vec<Lit>& ps, const vec<Int>& Cs, Int rhs, int ineq);
+    void    beginGroup  ();
 
     // Solve:
     //
@@ -434,6 +434,8 @@ struct Solver {
     //
     bool    okay(void) { return ok; }
     void    simplifyDB(bool subsume = false);
+    void    exportClauses(cchar* filename, vec<cchar*>& index2name, int n_splits, bool binary);
+    void    exportClauses(vec<Lit>& out);
     bool    solve(const vec<Lit>& assumps);
     bool    solve(void) { vec<Lit> empty; return solve(empty); }
 
@@ -451,12 +453,14 @@ struct Solver {
     void findSubsumed(Clause ps, vec<Clause>& out_subsumed);
     bool isSubsumed(Clause ps);
     bool hasClause(Clause ps);
-    void subsume0(Clause ps, int& counter = *(int*)NULL);
-    void subsume1(Clause ps, int& counter = *(int*)NULL);
+    void subsume0(Clause ps, int& counter);
+    void subsume1(Clause ps, int& counter);
+    void subsume0(Clause ps) { int counter = 0; subsume0(ps, counter); }   // (no null references -- compilers assume '&counter != NULL')
+    void subsume1(Clause ps) { int counter = 0; subsume1(ps, counter); }
     void simplifyBySubsumption(bool with_var_elim = true);
 
     void orderVarsForElim(vec<Var>& order);
-    int  substitute(Lit x, Clause def, vec<Clause>& poss, vec<Clause>& negs, vec<Clause>& new_clauses);
+    int  substitute(Lit x, Clause def, vec<Clause>& poss, vec<Clause>& negs, vec<Clause>* new_clauses = NULL);   // (no null references -- compilers assume they are never NULL)
     Lit  findUnitDef(Var x, vec<Clause>& poss, vec<Clause>& negs);
     bool findDef(Lit x, vec<Clause>& poss, vec<Clause>& negs, Clause out_def);
     bool maybeEliminate(Var x);
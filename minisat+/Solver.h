@@ -10,6 +10,7 @@
 class Solver {
     MiniSat ::Solver*   minisat;
     SatELite::Solver*   satelite;
+    vec<Lit>*           recording;      // If not NULL, clauses are appended here (each one terminated by 'lit_Undef') instead of being added.
 public:
     bool&             ok_ref     () { return (minisat != NULL) ? minisat->ok      : satelite->ok     ; }
     vec<int>&         assigns_ref() { return (minisat != NULL) ? minisat->assigns : satelite->assigns; }
@@ -23,8 +24,11 @@ public:
             satelite->verbosity = level; }
 
     Var         newVar         (bool dvar = true)   { return (minisat != NULL) ? minisat->newVar(dvar) : satelite->newVar(dvar); }
-    bool        addClause      (const vec<Lit>& ps) { return (minisat != NULL) ? minisat->addClause(ps) : (satelite->addClause(ps), satelite->okay()); }
-    bool        addUnit        (Lit p)              { return (minisat != NULL) ? minisat->addUnit(p) : (satelite->addUnit(p), satelite->okay()); }
+    bool        addClause      (const vec<Lit>& ps) { if (recording != NULL){ for (int i = 0; i < ps.size(); i++) recording->push(ps[i]); recording->push(lit_Undef); return true; }
+                                                      return (minisat != NULL) ? minisat->addClause(ps) : (satelite->addClause(ps), satelite->okay()); }
+    bool        addUnit        (Lit p)              { if (recording != NULL){ recording->push(p); recording->push(lit_Undef); return true; }
+                                                      return (minisat != NULL) ? minisat->addUnit(p) : (satelite->addUnit(p), satelite->okay()); }
+    void        record         (vec<Lit>* out)      { recording = out; }
     void        freeze         (Var x)              { if (minisat == NULL) satelite->freeze(x); }
     void        suggestPolarity(Var x, lbool value) { if (minisat != NULL) minisat->polarity_sug[x] = toInt(value); else satelite->polarity_sug[x] = toInt(value); }
     bool        solve     (const vec<Lit>& assumps) { return (minisat != NULL) ? minisat->solve(assumps) : satelite->solve(assumps); }
@@ -33,20 +37,33 @@ public:
     bool        varElimed      (Var x)              { return (minisat != NULL) ? false : satelite->var_elimed[x]; }
     bool        okay           ()                   { return (minisat != NULL) ? minisat->okay() : satelite->okay(); }
     int         nVars          ()                   { return (minisat != NULL) ? minisat->nVars() : satelite->nVars(); }
-    void        exportCnf      (cchar* filename, vec<cchar*>& index2name, int n_splits)    {
+    void        exportCnf      (cchar* filename, vec<cchar*>& index2name, int n_splits, bool binary = false)    {
         if (minisat != NULL){
             minisat->simplifyDB();
-            minisat->exportClauses(filename, index2name, n_splits);
+            if (binary) minisat->exportClausesBinary(filename, index2name, n_splits);
+            else        minisat->exportClauses(filename, index2name, n_splits);
         }else{
-
-            SatELite::opt_pre_sat = true;
-            SatELite::output_file = filename;
+            // Named variables are kept, only auxiliary ones are eliminated:
+            for (int i = 0; i < index2name.size() - n_splits; i++)
+                satelite->freeze(i);
             if (opt_verbosity >= 1) reportf("=================================[SATELITE+]==================================\n");
             satelite->simplifyDB(true);
+            satelite->exportClauses(filename, index2name, n_splits, binary);
+        } }
+    void        exportClauses  (vec<Lit>& out, int n_named) {     // Same simplifications as 'exportCnf()', clauses are appended to 'out' (each one terminated by 'lit_Undef').
+        if (minisat != NULL){
+            minisat->simplifyDB();
+            minisat->exportClauses(out);
+        }else{
+            for (int i = 0; i < n_named && i < satelite->nVars(); i++)
+                satelite->freeze(i);
+            satelite->simplifyDB(true);
+            satelite->exportClauses(out);
         } }
     //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 
-    Solver(bool use_minisat) : minisat(use_minisat ? new MiniSat::Solver : NULL), satelite(use_minisat ? NULL : new SatELite::Solver) {}
+    Solver(bool use_minisat) : minisat(use_minisat ? new MiniSat::Solver : NULL), satelite(use_minisat ? NULL : new SatELite::Solver), recording(NULL) {}
+   ~Solver() { delete minisat; delete satelite; }
 };
 
 
@@ -0,0 +1,155 @@
+/**
+ * @file cnf.cpp
+ * @brief Cnf class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+
+#include "cnf.hpp"
+
+using std::string;
+using std::vector;
+using std::ostream;
+using std::logic_error;
+
+namespace mc_hybrid
+{
+  Cnf::Cnf()
+  {
+    clear();
+  }
+
+  void
+  Cnf::clear()
+  {
+    names.clear();
+    vars_num = 0;
+    clauses_num = 0;
+    lits.clear();
+  }
+
+  void
+  Cnf::swap(Cnf& other)
+  {
+    names.swap(other.names);
+    std::swap(vars_num, other.vars_num);
+    std::swap(clauses_num, other.clauses_num);
+    lits.swap(other.lits);
+  }
+
+  size_t
+  Cnf::get_names_num() const
+  {
+    return names.size();
+  }
+
+  const string&
+  Cnf::get_name(size_t idx) const
+  {
+    return names.at(idx);
+  }
+
+  void
+  Cnf::add_name(const string& name)
+  {
+    if (clauses_num > 0)
+      throw logic_error("Can't add name to Cnf with clauses.");
+    names.push_back(name);
+    if (vars_num < names.size())
+      vars_num = names.size();
+  }
+
+  size_t
+  Cnf::get_vars_num() const
+  {
+    return vars_num;
+  }
+
+  size_t
+  Cnf::get_aux_num() const
+  {
+    return vars_num - names.size();
+  }
+
+  size_t
+  Cnf::get_clauses_num() const
+  {
+    return clauses_num;
+  }
+
+  void
+  Cnf::add_clause(const vector<int>& clause)
+  {
+    for (size_t i = 0; i < clause.size(); ++i)
+    {
+      if (clause[i] == 0)
+        throw logic_error("Zero literal in Cnf clause.");
+      size_t var = abs(clause[i]);
+      if (var > vars_num)
+        vars_num = var;
+      lits.push_back(clause[i]);
+    }
+    lits.push_back(0);
+    ++clauses_num;
+  }
+
+  const vector<int>&
+  Cnf::get_lits() const
+  {
+    return lits;
+  }
+
+  size_t
+  Cnf::write_smv(ostream& s, size_t aux_num) const
+  {
+    // SMV names of named variables are resolved once.
+    vector<string> table(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+      const string& name = names[i];
+      if (name[name.length() - 1] == '\'')
+        table[i] = "next(" + name.substr(0, name.length() - 1) + ")";
+      else
+        table[i] = name;
+    }
+
+    bool clause_start = true;
+    for (size_t i = 0; i < lits.size(); ++i)
+    {
+      if (clause_start)
+      {
+        if (i > 0)
+          s << " & ";
+        if (lits[i] == 0)
+        {
+          s << "FALSE";
+          continue;
+        }
+        s << "(";
+        clause_start = false;
+      }
+      else if (lits[i] != 0)
+        s << " | ";
+
+      if (lits[i] == 0)
+      {
+        s << ")";
+        clause_start = true;
+        continue;
+      }
+
+      if (lits[i] < 0)
+        s << "!";
+      size_t var = abs(lits[i]);
+      if (var <= table.size())
+        s << table[var - 1];
+      else
+        s << "_aux" << aux_num + var - names.size() - 1;
+    }
+
+    return aux_num + get_aux_num();
+  }
+}; // namespace mc_hybrid
@@ -0,0 +1,138 @@
+/**
+ * @file cnf.hpp
+ * @brief Cnf class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef CNF_HPP_
+#define CNF_HPP_
+
+#include <vector>
+#include <string>
+#include <ostream>
+
+namespace mc_hybrid
+{
+  /**
+   * @brief CNF produced by minisat+.
+   *
+   * Variables are numbered from 1, literals are nonzero integers (negative
+   * for negated variables). First variables are named (they are variables
+   * of the pseudoboolean problem), the rest are aux variables introduced by
+   * minisat+.
+   */
+  class Cnf
+  {
+    public:
+      /**
+       * @brief Default constructor.
+       */
+      Cnf();
+
+      /**
+       * @brief Removes all names and clauses.
+       */
+      void
+      clear();
+
+      /**
+       * @brief Exchanges contents with other CNF.
+       *
+       * @param[in,out] other Other CNF.
+       */
+      void
+      swap(Cnf& other);
+
+      /**
+       * @brief Gets named variables number.
+       *
+       * @return Named variables number.
+       */
+      size_t
+      get_names_num() const;
+
+      /**
+       * @brief Gets name of variable.
+       *
+       * @param[in] idx Index of named variable (variable number - 1).
+       *
+       * @return Variable name.
+       */
+      const std::string&
+      get_name(size_t idx) const;
+
+      /**
+       * @brief Adds named variable.
+       *
+       * @attention Must be called before adding clauses.
+       *
+       * @param[in] name Variable name.
+       */
+      void
+      add_name(const std::string& name);
+
+      /**
+       * @brief Gets variables number (named and aux).
+       *
+       * @return Variables number.
+       */
+      size_t
+      get_vars_num() const;
+
+      /**
+       * @brief Gets aux variables number.
+       *
+       * @return Aux variables number.
+       */
+      size_t
+      get_aux_num() const;
+
+      /**
+       * @brief Gets clauses number.
+       *
+       * @return Clauses number.
+       */
+      size_t
+      get_clauses_num() const;
+
+      /**
+       * @brief Adds clause.
+       *
+       * Empty clause makes CNF unsatisfiable.
+       *
+       * @param[in] clause Literals of clause.
+       */
+      void
+      add_clause(const std::vector<int>& clause);
+
+      /**
+       * @brief Gets literals of all clauses.
+       *
+       * @return Literals of clauses, each clause is terminated by 0.
+       */
+      const std::vector<int>&
+      get_lits() const;
+
+      /**
+       * @brief Writes CNF as SMV expression.
+       *
+       * Next state variables are written as next(), aux variables are
+       * named _aux<i> starting from aux_num.
+       *
+       * @param[out] s       Output stream.
+       * @param[in]  aux_num Aux vars number.
+       *
+       * @return New aux vars number.
+       */
+      size_t
+      write_smv(std::ostream& s, size_t aux_num) const;
+
+    private:
+      std::vector<std::string> names; ///< Names of named variables.
+      size_t vars_num;                ///< Variables number.
+      size_t clauses_num;             ///< Clauses number.
+      std::vector<int> lits;          ///< Literals of clauses.
+  }; // class Cnf
+}; // namespace mc_hybrid
+
+#endif // #ifndef CNF_HPP_
@@ -6,6 +6,7 @@
  */
 
 #include <ostream>
+#include <vector>
 
 #include "types.hpp"
 #include "variable.hpp"
@@ -15,6 +16,7 @@ using std::string;
 using std::ostream;
 using std::endl;
 using std::map;
+using std::vector;
 
 namespace mc_hybrid
 {
@@ -89,6 +91,34 @@ namespace mc_hybrid
     free_member *= num;
   }
 
+  const map<string, real_t>&
+  Constraint::get_coeffs() const
+  {
+    return coeffs;
+  }
+
+  void
+  Constraint::canonicalize()
+  {
+    map<string, real_t>::iterator iter;
+    vector<int_t> dens;
+    for (iter = coeffs.begin(); iter != coeffs.end(); ++iter)
+      dens.push_back(iter->second.get_den());
+    dens.push_back(free_member.get_den());
+    mult(lcf(dens));
+
+    int_t divisor = abs(free_member.get_num());
+    for (iter = coeffs.begin(); iter != coeffs.end(); ++iter)
+      divisor = gcd(divisor, iter->second.get_num());
+    if (divisor == 0)
+      return;
+    // Equality can be multiplied by negative number too.
+    if (type == EQUAL && !coeffs.empty() && coeffs.begin()->second < 0)
+      divisor = -divisor;
+    if (divisor != 1)
+      mult(real_t(1) / divisor);
+  }
+
   ostream&
   operator<<(ostream& s, Constraint& c)
   {
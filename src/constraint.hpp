@@ -121,6 +121,25 @@ namespace mc_hybrid
       void
       mult(real_t num);
 
+      /**
+       * @brief Gets nonzero coefficients.
+       *
+       * @return Coefficients by variable names.
+       */
+      const std::map<std::string, real_t>&
+      get_coeffs() const;
+
+      /**
+       * @brief Brings constraint to canonical form.
+       *
+       * Coefficients and free member are made coprime integers, the first
+       * coefficient of equality is made positive. Equivalent constraints
+       * (up to a positive factor, or any factor for equalities) get the
+       * same form.
+       */
+      void
+      canonicalize();
+
       friend std::ostream&
       operator<<(std::ostream& s, Constraint& c);
 
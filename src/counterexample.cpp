@@ -202,7 +202,7 @@ namespace mc_hybrid
   Counterexample::get_ivar_value(size_t step,
                                 const string& var_name) const
   {
-    if (vars_state_names.count(var_name) != 0)
+    if (vars_input_names.count(var_name) != 0)
     {
       size_t idx = vars_input_names.find(var_name)->second;
       return vars_input_values.at(step).at(idx);
@@ -0,0 +1,55 @@
+/**
+ * @file engine_bmc.cpp
+ * @brief Engine_bmc class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <vector>
+
+#include "sat_solver.hpp"
+#include "model_cnf.hpp"
+#include "engine_bmc.hpp"
+
+using std::vector;
+
+namespace mc_hybrid
+{
+  Engine_bmc::Engine_bmc(Model_cnf& model, size_t max_depth) :
+    model(model),
+    max_depth(max_depth)
+  {
+  }
+
+  bool
+  Engine_bmc::verify(Counterexample*& ce)
+  {
+    Sat_solver solver;
+    vector<vector<int> > states;
+    vector<vector<int> > inputs;
+
+    states.push_back(model.new_state(solver));
+    model.add_init(solver, states[0], 0);
+
+    for (size_t depth = 0; ; ++depth)
+    {
+      int act = solver.new_var();
+      model.add_bad(solver, states[depth], act);
+      vector<int> assumps(1, act);
+      if (solver.solve(assumps))
+      {
+        model.get_counterexample(solver, states, inputs, ce);
+        return false;
+      }
+      // Negation of specification at this depth is never needed again.
+      solver.add_clause(vector<int>(1, -act));
+
+      if (depth == max_depth)
+        break;
+      inputs.push_back(model.new_input(solver));
+      states.push_back(model.new_state(solver));
+      model.add_trans(solver, states[depth], inputs[depth], states[depth + 1], 0);
+    }
+
+    return true;
+  }
+}; // namespace mc_hybrid
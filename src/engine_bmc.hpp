@@ -0,0 +1,51 @@
+/**
+ * @file engine_bmc.hpp
+ * @brief Engine_bmc class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef ENGINE_BMC_HPP_
+#define ENGINE_BMC_HPP_
+
+#include <cstddef>
+
+namespace mc_hybrid
+{
+  class Model_cnf;
+  class Counterexample;
+
+  /**
+   * @brief Bounded model checking engine.
+   *
+   * Unrolls transitional relation in one incremental SAT solver, one frame
+   * per depth. Negation of specification at each depth is checked under
+   * activation literal, so learnt clauses are kept between depths.
+   */
+  class Engine_bmc
+  {
+    public:
+      /**
+       * @brief Constructor.
+       *
+       * @param[in] model     CNF model.
+       * @param[in] max_depth Maximal number of transitions to unroll.
+       */
+      Engine_bmc(Model_cnf& model, size_t max_depth);
+
+      /**
+       * @brief Looks for counterexample up to maximal depth.
+       *
+       * @param[out] ce Counterexample, it is allocated if verification fails.
+       *
+       * @return false if counterexample is found, true otherwise.
+       */
+      bool
+      verify(Counterexample*& ce);
+
+    private:
+      Model_cnf& model; ///< CNF model.
+      size_t max_depth; ///< Maximal number of transitions to unroll.
+  }; // class Engine_bmc
+}; // namespace mc_hybrid
+
+#endif // #ifndef ENGINE_BMC_HPP_
@@ -0,0 +1,364 @@
+/**
+ * @file engine_ic3.cpp
+ * @brief Engine_ic3 class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+#include <queue>
+#include <functional>
+
+#include "types.hpp"
+#include "variable.hpp"
+#include "constraint.hpp"
+#include "problem.hpp"
+#include "counterexample.hpp"
+#include "sat_solver.hpp"
+#include "model_cnf.hpp"
+#include "engine_ic3.hpp"
+
+using std::vector;
+using std::ostream;
+using std::pair;
+using std::make_pair;
+using std::priority_queue;
+using std::greater;
+using std::logic_error;
+
+namespace mc_hybrid
+{
+  /**
+   * @brief Index of absent obligation.
+   */
+  static const size_t no_obligation = size_t(-1);
+
+  /**
+   * @brief Converts cube literal into solver literal.
+   *
+   * @param[in] vars Solver variables.
+   * @param[in] lit  Cube literal.
+   *
+   * @return Solver literal.
+   */
+  static int
+  to_solver_lit(const vector<int>& vars, int lit)
+  {
+    return (lit > 0) ? vars[lit - 1] : -vars[-lit - 1];
+  }
+
+  Engine_ic3::Engine_ic3(Model_cnf& model) :
+    model(model),
+    init(0),
+    fixpoint(0)
+  {
+  }
+
+  Engine_ic3::~Engine_ic3()
+  {
+    if (init)
+      delete init;
+    init = 0;
+
+    for (size_t i = 0; i < solvers.size(); ++i)
+      delete solvers[i];
+    solvers.clear();
+  }
+
+  bool
+  Engine_ic3::verify(Counterexample*& ce)
+  {
+    if (init)
+      delete init;
+    for (size_t i = 0; i < solvers.size(); ++i)
+      delete solvers[i];
+    solvers.clear();
+    bad_acts.clear();
+    trans_acts.clear();
+    lemmas.clear();
+    fixpoint = 0;
+
+    init = new Sat_solver();
+    model.add_init(*init, model.new_state(*init), 0);
+
+    // Initial states violating specification.
+    add_frame();
+    if (solvers[0]->solve(vector<int>(1, bad_acts[0])))
+    {
+      vector<Obligation> obligations(1);
+      obligations[0].cube = get_cube(*solvers[0], state);
+      obligations[0].level = 0;
+      obligations[0].succ = no_obligation;
+      get_counterexample(obligations, 0, ce);
+      return false;
+    }
+
+    add_frame();
+    for (;;)
+    {
+      size_t n = solvers.size() - 1;
+      while (solvers[n]->solve(vector<int>(1, bad_acts[n])))
+      {
+        vector<int> cube = get_cube(*solvers[n], state);
+        if (!block(cube, ce))
+          return false;
+      }
+      add_frame();
+      if (propagate())
+        return true;
+    }
+  }
+
+  void
+  Engine_ic3::write_invariant(ostream& s)
+  {
+    bool first = true;
+    for (size_t k = fixpoint + 1; k < lemmas.size(); ++k)
+      for (size_t i = 0; i < lemmas[k].size(); ++i)
+      {
+        const vector<int>& cube = lemmas[k][i];
+        if (!first)
+          s << " & ";
+        first = false;
+        s << "(";
+        for (size_t j = 0; j < cube.size(); ++j)
+        {
+          if (j > 0)
+            s << " | ";
+          Variable& v = model.get_problem().get_variable(Problem::VARS_STATE,
+                                                         abs(cube[j]) - 1);
+          if (cube[j] > 0)
+            s << "!";
+          s << v.get_name();
+        }
+        s << ")";
+      }
+    if (first)
+      s << "TRUE";
+  }
+
+  void
+  Engine_ic3::add_frame()
+  {
+    Sat_solver* solver = new Sat_solver();
+    vector<int> s = model.new_state(*solver);
+    vector<int> i = model.new_input(*solver);
+    vector<int> n = model.new_state(*solver);
+    if (solvers.size() == 0)
+    {
+      state = s;
+      input = i;
+      next = n;
+    }
+    else if (s != state || i != input || n != next)
+      throw logic_error("Frames variables differ in IC3 solvers.");
+
+    if (solvers.size() == 0)
+      model.add_init(*solver, state, 0);
+    int trans_act = solver->new_var();
+    model.add_trans(*solver, state, input, next, trans_act);
+    int bad_act = solver->new_var();
+    model.add_bad(*solver, state, bad_act);
+
+    solvers.push_back(solver);
+    bad_acts.push_back(bad_act);
+    trans_acts.push_back(trans_act);
+    lemmas.push_back(vector<vector<int> >());
+  }
+
+  bool
+  Engine_ic3::intersects_init(const vector<int>& cube)
+  {
+    vector<int> assumps;
+    for (size_t i = 0; i < cube.size(); ++i)
+      assumps.push_back(to_solver_lit(state, cube[i]));
+    return init->solve(assumps);
+  }
+
+  bool
+  Engine_ic3::relative_inductive(size_t k,
+                                 const vector<int>& cube,
+                                 Obligation* pred)
+  {
+    Sat_solver& solver = *solvers.at(k);
+
+    // Temporary clause !cube is active only under act.
+    int act = solver.new_var();
+    vector<int> clause(1, -act);
+    vector<int> assumps(1, act);
+    assumps.push_back(trans_acts.at(k));
+    for (size_t i = 0; i < cube.size(); ++i)
+    {
+      clause.push_back(-to_solver_lit(state, cube[i]));
+      assumps.push_back(to_solver_lit(next, cube[i]));
+    }
+    solver.add_clause(clause);
+
+    bool sat = solver.solve(assumps);
+    if (sat && pred != 0)
+    {
+      pred->cube = get_cube(solver, state);
+      pred->inputs = get_cube(solver, input);
+    }
+
+    solver.add_clause(vector<int>(1, -act));
+
+    return !sat;
+  }
+
+  void
+  Engine_ic3::generalize(size_t k, vector<int>& cube)
+  {
+    for (size_t i = 0; i < cube.size() && cube.size() > 1; )
+    {
+      vector<int> candidate(cube);
+      candidate.erase(candidate.begin() + i);
+      if (!intersects_init(candidate) &&
+          relative_inductive(k - 1, candidate, 0))
+        cube = candidate;
+      else
+        ++i;
+    }
+  }
+
+  void
+  Engine_ic3::add_lemma(size_t k, const vector<int>& cube)
+  {
+    lemmas[k].push_back(cube);
+    vector<int> clause;
+    for (size_t i = 0; i < cube.size(); ++i)
+      clause.push_back(-to_solver_lit(state, cube[i]));
+    for (size_t i = 1; i <= k; ++i)
+      solvers[i]->add_clause(clause);
+  }
+
+  bool
+  Engine_ic3::block(const vector<int>& cube, Counterexample*& ce)
+  {
+    size_t n = solvers.size() - 1;
+
+    vector<Obligation> obligations(1);
+    obligations[0].cube = cube;
+    obligations[0].level = n;
+    obligations[0].succ = no_obligation;
+
+    // Obligations with lower level first.
+    priority_queue<pair<size_t, size_t>,
+                   vector<pair<size_t, size_t> >,
+                   greater<pair<size_t, size_t> > > queue;
+    queue.push(make_pair(n, 0));
+    while (!queue.empty())
+    {
+      size_t idx = queue.top().second;
+      queue.pop();
+
+      if (intersects_init(obligations[idx].cube))
+      {
+        get_counterexample(obligations, idx, ce);
+        return false;
+      }
+      size_t level = obligations[idx].level;
+      if (level == 0)
+        throw logic_error("Obligation at F_0 doesn't intersect initial states.");
+
+      Obligation pred;
+      if (relative_inductive(level - 1, obligations[idx].cube, &pred))
+      {
+        vector<int> lemma(obligations[idx].cube);
+        generalize(level, lemma);
+        size_t k = level;
+        while (k < n && relative_inductive(k, lemma, 0))
+          ++k;
+        add_lemma(k, lemma);
+        // Look for longer counterexamples through the same state.
+        if (k < n)
+        {
+          obligations[idx].level = k + 1;
+          queue.push(make_pair(k + 1, idx));
+        }
+      }
+      else
+      {
+        pred.level = level - 1;
+        pred.succ = idx;
+        obligations.push_back(pred);
+        queue.push(make_pair(level - 1, obligations.size() - 1));
+        queue.push(make_pair(level, idx));
+      }
+    }
+
+    return true;
+  }
+
+  bool
+  Engine_ic3::propagate()
+  {
+    size_t n = solvers.size() - 1;
+    for (size_t k = 1; k < n; ++k)
+    {
+      vector<vector<int> > kept;
+      for (size_t i = 0; i < lemmas[k].size(); ++i)
+      {
+        const vector<int>& cube = lemmas[k][i];
+        if (relative_inductive(k, cube, 0))
+        {
+          lemmas[k + 1].push_back(cube);
+          vector<int> clause;
+          for (size_t j = 0; j < cube.size(); ++j)
+            clause.push_back(-to_solver_lit(state, cube[j]));
+          solvers[k + 1]->add_clause(clause);
+        }
+        else
+          kept.push_back(cube);
+      }
+      lemmas[k].swap(kept);
+      if (lemmas[k].size() == 0)
+      {
+        fixpoint = k;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void
+  Engine_ic3::get_counterexample(const vector<Obligation>& obligations,
+                                 size_t first,
+                                 Counterexample*& ce)
+  {
+    Problem& problem = model.get_problem();
+    if (ce != 0)
+      delete ce;
+    ce = new Counterexample(problem);
+
+    size_t step = 0;
+    for (size_t idx = first; idx != no_obligation; idx = obligations[idx].succ)
+    {
+      ce->add_step();
+      const vector<int>& cube = obligations[idx].cube;
+      for (size_t i = 0; i < cube.size(); ++i)
+        ce->set_var_value(step,
+                          problem.get_variable(Problem::VARS_STATE, abs(cube[i]) - 1).get_name(),
+                          cube[i] > 0 ? 1 : 0);
+      if (obligations[idx].succ != no_obligation)
+      {
+        const vector<int>& inputs = obligations[idx].inputs;
+        for (size_t i = 0; i < inputs.size(); ++i)
+          ce->set_ivar_value(step,
+                             problem.get_variable(Problem::VARS_INPUT, abs(inputs[i]) - 1).get_name(),
+                             inputs[i] > 0 ? 1 : 0);
+      }
+      ++step;
+    }
+  }
+
+  vector<int>
+  Engine_ic3::get_cube(const Sat_solver& solver, const vector<int>& vars)
+  {
+    vector<int> cube;
+    for (size_t i = 0; i < vars.size(); ++i)
+      cube.push_back(solver.get_value(vars[i]) ? int(i + 1) : -int(i + 1));
+    return cube;
+  }
+}; // namespace mc_hybrid
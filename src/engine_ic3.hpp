@@ -0,0 +1,197 @@
+/**
+ * @file engine_ic3.hpp
+ * @brief Engine_ic3 class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef ENGINE_IC3_HPP_
+#define ENGINE_IC3_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <ostream>
+
+namespace mc_hybrid
+{
+  class Model_cnf;
+  class Sat_solver;
+  class Counterexample;
+
+  /**
+   * @brief IC3/PDR engine.
+   *
+   * Keeps frames F_0 = INIT, F_1, ..., F_N of clauses over state variables,
+   * every frame has its own incremental SAT solver with transitional
+   * relation and clauses of the frame. Temporary clauses of queries are
+   * guarded by activation literals. Cubes are sets of literals over state
+   * variables: i + 1 (or -(i + 1)) stands for i-th state variable being
+   * true (or false).
+   */
+  class Engine_ic3
+  {
+    public:
+      /**
+       * @brief Constructor.
+       *
+       * @param[in] model CNF model.
+       */
+      Engine_ic3(Model_cnf& model);
+
+      /**
+       * @brief Destructor.
+       *
+       * Frees solvers.
+       */
+      ~Engine_ic3();
+
+      /**
+       * @brief Proves or disproves specification.
+       *
+       * @param[out] ce Counterexample, it is allocated if verification fails.
+       *
+       * @return true if model fits specification, false otherwise.
+       */
+      bool
+      verify(Counterexample*& ce);
+
+      /**
+       * @brief Writes inductive invariant found by the last verification.
+       *
+       * @param[out] s Output stream.
+       */
+      void
+      write_invariant(std::ostream& s);
+
+    private:
+      /**
+       * @brief Proof obligation: cube to block at level.
+       */
+      struct Obligation
+      {
+        std::vector<int> cube;   ///< Full state.
+        std::vector<int> inputs; ///< Inputs leading to successor.
+        size_t level;            ///< Frame to block cube in.
+        size_t succ;             ///< Successor obligation index.
+      }; // struct Obligation
+
+      /**
+       * @brief Adds new frame with its solver.
+       *
+       * Transition relation is active only under activation literal, so
+       * bad states of frame are found whether they have successor or not.
+       */
+      void
+      add_frame();
+
+      /**
+       * @brief Checks if cube intersects initial states.
+       *
+       * @param[in] cube Cube.
+       *
+       * @return true if cube contains initial state, false otherwise.
+       */
+      bool
+      intersects_init(const std::vector<int>& cube);
+
+      /**
+       * @brief Checks if cube is inductive relative to frame.
+       *
+       * Checks F_k & !cube & T & cube' for satisfiability.
+       *
+       * @param[in]  k    Frame index.
+       * @param[in]  cube Cube.
+       * @param[out] pred Predecessor state and inputs leading to cube,
+       *                  filled if cube is not relative inductive (can be 0).
+       *
+       * @return true if formula is unsatisfiable, false otherwise.
+       */
+      bool
+      relative_inductive(size_t k,
+                         const std::vector<int>& cube,
+                         Obligation* pred);
+
+      /**
+       * @brief Drops literals from cube keeping it relative inductive.
+       *
+       * @param[in]     k    Frame index.
+       * @param[in,out] cube Cube.
+       */
+      void
+      generalize(size_t k, std::vector<int>& cube);
+
+      /**
+       * @brief Adds clause !cube to frames 1 .. k.
+       *
+       * @param[in] k    Frame index.
+       * @param[in] cube Cube.
+       */
+      void
+      add_lemma(size_t k, const std::vector<int>& cube);
+
+      /**
+       * @brief Blocks bad cube found in the last frame.
+       *
+       * @param[in]  cube Bad state.
+       * @param[out] ce   Counterexample, it is allocated if cube can't be
+       *                  blocked.
+       *
+       * @return true if cube is blocked, false otherwise.
+       */
+      bool
+      block(const std::vector<int>& cube, Counterexample*& ce);
+
+      /**
+       * @brief Pushes lemmas to the next frames.
+       *
+       * @return true if two equal frames are found, false otherwise.
+       */
+      bool
+      propagate();
+
+      /**
+       * @brief Builds counterexample from chain of obligations.
+       *
+       * @param[in]  obligations Obligations.
+       * @param[in]  first       Index of obligation with initial state.
+       * @param[out] ce          Counterexample.
+       */
+      void
+      get_counterexample(const std::vector<Obligation>& obligations,
+                         size_t first,
+                         Counterexample*& ce);
+
+      /**
+       * @brief Gets model values of variables as cube.
+       *
+       * @param[in] solver SAT solver after successful solve.
+       * @param[in] vars   Variables.
+       *
+       * @return Cube.
+       */
+      std::vector<int>
+      get_cube(const Sat_solver& solver, const std::vector<int>& vars);
+
+    private:
+      Model_cnf& model; ///< CNF model.
+
+      std::vector<int> state; ///< Current state variables in every solver.
+      std::vector<int> input; ///< Input variables in every solver.
+      std::vector<int> next;  ///< Next state variables in every solver.
+
+      Sat_solver* init;                 ///< Solver with initial conditions.
+      std::vector<Sat_solver*> solvers; ///< Solvers of frames.
+      std::vector<int> bad_acts;        ///< Activation literals of bad states.
+      std::vector<int> trans_acts;      ///< Activation literals of transitions.
+
+      /**
+       * @brief Cubes blocked exactly at each frame.
+       */
+      std::vector<std::vector<std::vector<int> > > lemmas;
+      /**
+       * @brief Index of the frame equal to the next one.
+       */
+      size_t fixpoint;
+  }; // class Engine_ic3
+}; // namespace mc_hybrid
+
+#endif // #ifndef ENGINE_IC3_HPP_
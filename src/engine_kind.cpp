@@ -0,0 +1,95 @@
+/**
+ * @file engine_kind.cpp
+ * @brief Engine_kind class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <vector>
+
+#include "sat_solver.hpp"
+#include "model_cnf.hpp"
+#include "engine_kind.hpp"
+
+using std::vector;
+
+namespace mc_hybrid
+{
+  Engine_kind::Engine_kind(Model_cnf& model, size_t max_k) :
+    model(model),
+    max_k(max_k),
+    k(0)
+  {
+  }
+
+  Engine_kind::Result
+  Engine_kind::verify(Counterexample*& ce)
+  {
+    // Base case: path from initial state.
+    Sat_solver base;
+    vector<vector<int> > base_states;
+    vector<vector<int> > base_inputs;
+    base_states.push_back(model.new_state(base));
+    model.add_init(base, base_states[0], 0);
+
+    // Step case: path of states satisfying specification.
+    Sat_solver step;
+    vector<vector<int> > step_states;
+    vector<vector<int> > step_inputs;
+    step_states.push_back(model.new_state(step));
+
+    for (k = 0; ; ++k)
+    {
+      int act = base.new_var();
+      model.add_bad(base, base_states[k], act);
+      vector<int> assumps(1, act);
+      if (base.solve(assumps))
+      {
+        model.get_counterexample(base, base_states, base_inputs, ce);
+        return RESULT_FAILS;
+      }
+      base.add_clause(vector<int>(1, -act));
+
+      act = step.new_var();
+      model.add_bad(step, step_states[k], act);
+      assumps.assign(1, act);
+      for (;;)
+      {
+        if (!step.solve(assumps))
+          return RESULT_HOLDS;
+
+        // Look for the pair of equal states on the path.
+        bool found = false;
+        for (size_t i = 0; i < k && !found; ++i)
+          for (size_t j = i + 1; j <= k && !found; ++j)
+            if (model.equal_states(step, step_states[i], step_states[j]))
+            {
+              model.add_distinct(step, step_states[i], step_states[j]);
+              found = true;
+            }
+        if (!found)
+          break;
+      }
+      step.add_clause(vector<int>(1, -act));
+
+      if (k == max_k)
+        break;
+
+      base_inputs.push_back(model.new_input(base));
+      base_states.push_back(model.new_state(base));
+      model.add_trans(base, base_states[k], base_inputs[k], base_states[k + 1], 0);
+
+      step_inputs.push_back(model.new_input(step));
+      step_states.push_back(model.new_state(step));
+      model.add_spec(step, step_states[k], 0);
+      model.add_trans(step, step_states[k], step_inputs[k], step_states[k + 1], 0);
+    }
+
+    return RESULT_UNKNOWN;
+  }
+
+  size_t
+  Engine_kind::get_k() const
+  {
+    return k;
+  }
+}; // namespace mc_hybrid
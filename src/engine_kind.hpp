@@ -0,0 +1,74 @@
+/**
+ * @file engine_kind.hpp
+ * @brief Engine_kind class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef ENGINE_KIND_HPP_
+#define ENGINE_KIND_HPP_
+
+#include <cstddef>
+
+namespace mc_hybrid
+{
+  class Model_cnf;
+  class Counterexample;
+
+  /**
+   * @brief k-induction engine.
+   *
+   * For k = 0, 1, ... checks base case (no bad state is reachable in k
+   * transitions, as in BMC) and step case (k consecutive states satisfying
+   * specification are never followed by bad state). Both cases are checked
+   * in their own incremental SAT solvers. Simple path constraints for the
+   * step case are added lazily: only for pairs of equal states met in
+   * solver models.
+   */
+  class Engine_kind
+  {
+    public:
+      /**
+       * @brief Verification results enum.
+       */
+      enum Result
+      {
+        RESULT_HOLDS = 0, ///< Specification is k-inductive.
+        RESULT_FAILS,     ///< Counterexample is found.
+        RESULT_UNKNOWN    ///< Maximal k is reached.
+      }; // enum Result
+
+    public:
+      /**
+       * @brief Constructor.
+       *
+       * @param[in] model CNF model.
+       * @param[in] max_k Maximal k.
+       */
+      Engine_kind(Model_cnf& model, size_t max_k);
+
+      /**
+       * @brief Tries to prove or disprove specification.
+       *
+       * @param[out] ce Counterexample, it is allocated if verification fails.
+       *
+       * @return Verification result.
+       */
+      Result
+      verify(Counterexample*& ce);
+
+      /**
+       * @brief Gets k of the last verification.
+       *
+       * @return k at which specification was proved or disproved.
+       */
+      size_t
+      get_k() const;
+
+    private:
+      Model_cnf& model; ///< CNF model.
+      size_t max_k;     ///< Maximal k.
+      size_t k;         ///< k of the last verification.
+  }; // class Engine_kind
+}; // namespace mc_hybrid
+
+#endif // #ifndef ENGINE_KIND_HPP_
@@ -8,12 +8,14 @@
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
+#include <cstring>
 
 #include <getopt.h>
 
 #include <xercesc/util/PlatformUtils.hpp>
 
 #include "types.hpp"
+#include "options.hpp"
 #include "solver.hpp"
 
 using namespace std;
@@ -32,8 +34,26 @@ void
 usage(const char* filename)
 {
   cout << "Prototype of model checker for hybrid systems " << APP_VERSION_STR        << endl;
-  cout << "usage: " << filename << " [-v level] [-q value] filename "                << endl;
+  cout << "usage: " << filename << " [-v level] [-q value] [-e engine] [-a algorithm] [-b] [-k depth] [-c] [-t timeout] [-n [var=]encoding] [-x] [-p] [-j threads] [-u sample] filename" << endl;
   cout << "       read model from \"filename\" and verify with \"value\" of q_param" << endl;
+  cout << "       using \"engine\" (nusmv, bdd, bmc, kind or ic3, default is nusmv)" << endl;
+  cout << "       -a selects NuSMV invariant checking \"algorithm\" (bdd or bmc,"    << endl;
+  cout << "          default is bdd)"                                                << endl;
+  cout << "       -b selects backward reachability for bdd engine and algorithm"     << endl;
+  cout << "       -k sets maximal \"depth\" for bmc and kind engines and bmc"        << endl;
+  cout << "          algorithm (default is 20)"                                      << endl;
+  cout << "       -c enables cone of influence reduction in NuSMV"                   << endl;
+  cout << "       -t sets NuSMV query \"timeout\" in seconds (default is none)"      << endl;
+  cout << "       -n selects \"encoding\" of discrete variables by boolean ones"     << endl;
+  cout << "          (binary, order, onehot or auto, default is binary), with"       << endl;
+  cout << "          \"var=\" only for variable \"var\" (may be repeated)"           << endl;
+  cout << "       -x eliminates quantization deltas by their bounds instead of"    << endl;
+  cout << "          Fourier-Motzkin (fast, counterexamples may be spurious)"       << endl;
+  cout << "       -p disables elimination of aux variables of CNFs by SatELite"     << endl;
+  cout << "       -j sets number of \"threads\" converting constraints to circuits" << endl;
+  cout << "          (default is 1, 0 means number of processors)"              << endl;
+  cout << "       -u tunes thresholds of minisat+ mixed encoding on \"sample\" of"  << endl;
+  cout << "          constraints and prints them (default is no tuning)"           << endl;
   cout << "   or: " << filename << " -h"                                             << endl;
   cout << "       print help message"                                                << endl;
 }
@@ -51,14 +71,24 @@ main(int argc, char* argv[])
 {
   string filename;
   // defaults
-  int verbose = 1;
-  int q_param = 4;
+  mc_hybrid::Options opts;
 
   static struct option options[] =
   {
     {"help", 0, 0, 'h'},
     {"verbose", 1, 0, 'v'},
     {"q_param", 1, 0, 'q'},
+    {"engine", 1, 0, 'e'},
+    {"backward", 0, 0, 'b'},
+    {"depth", 1, 0, 'k'},
+    {"algorithm", 1, 0, 'a'},
+    {"coi", 0, 0, 'c'},
+    {"timeout", 1, 0, 't'},
+    {"encoding", 1, 0, 'n'},
+    {"approximate", 0, 0, 'x'},
+    {"no-preprocess", 0, 0, 'p'},
+    {"threads", 1, 0, 'j'},
+    {"tune", 1, 0, 'u'},
     {0, 0, 0, 0}
   };
 
@@ -68,7 +98,7 @@ main(int argc, char* argv[])
 
   for (;;)
   {
-    c = getopt_long(argc, argv, "q:v:h", options, &opt_idx);
+    c = getopt_long(argc, argv, "q:v:e:bk:a:ct:n:xpj:u:h", options, &opt_idx);
     if (c == -1)
       break;
 
@@ -79,11 +109,97 @@ main(int argc, char* argv[])
         return 1;
 
       case 'v':
-        verbose = atoi(optarg);
+        opts.verbosity = atoi(optarg);
         break;
 
       case 'q':
-        q_param = atoi(optarg);
+        opts.q_param = atoi(optarg);
+        break;
+
+      case 'e':
+        {
+          int i = 0;
+          while (i < mc_hybrid::Options::ENGINES_TOTAL &&
+                 strcmp(optarg, mc_hybrid::engines_names[i]) != 0)
+            ++i;
+          if (i == mc_hybrid::Options::ENGINES_TOTAL)
+          {
+            cout << "unknown engine \"" << optarg << "\"" << endl << endl;
+            usage(argv[0]);
+            return 1;
+          }
+          opts.engine = mc_hybrid::Options::Engine(i);
+        }
+        break;
+
+      case 'b':
+        opts.backward = true;
+        break;
+
+      case 'k':
+        opts.depth = atoi(optarg);
+        break;
+
+      case 'a':
+        {
+          int i = 0;
+          while (i < mc_hybrid::Options::NUSMV_ALGORITHMS_TOTAL &&
+                 strcmp(optarg, mc_hybrid::nusmv_algorithms_names[i]) != 0)
+            ++i;
+          if (i == mc_hybrid::Options::NUSMV_ALGORITHMS_TOTAL)
+          {
+            cout << "unknown algorithm \"" << optarg << "\"" << endl << endl;
+            usage(argv[0]);
+            return 1;
+          }
+          opts.nusmv_algorithm = mc_hybrid::Options::Nusmv_algorithm(i);
+        }
+        break;
+
+      case 'c':
+        opts.coi = true;
+        break;
+
+      case 't':
+        opts.timeout = atoi(optarg);
+        break;
+
+      case 'n':
+        {
+          const char* eq = strchr(optarg, '=');
+          const char* value = eq != 0 ? eq + 1 : optarg;
+          int i = 0;
+          while (i < mc_hybrid::Options::ENCODINGS_TOTAL &&
+                 strcmp(value, mc_hybrid::encodings_names[i]) != 0)
+            ++i;
+          if (i == mc_hybrid::Options::ENCODINGS_TOTAL)
+          {
+            cout << "unknown encoding \"" << value << "\"" << endl << endl;
+            usage(argv[0]);
+            return 1;
+          }
+          if (eq != 0)
+            opts.vars_encodings[string(optarg, eq - optarg)] =
+              mc_hybrid::Options::Encoding(i);
+          else
+            opts.encoding = mc_hybrid::Options::Encoding(i);
+        }
+        break;
+
+      case 'x':
+        opts.approximate = true;
+        break;
+
+      case 'p':
+        opts.preprocess = false;
+        break;
+
+      case 'j':
+        opts.threads = atoi(optarg);
+        break;
+
+      case 'u':
+        opts.tune = atoi(optarg);
         break;
 
       case '?':
@@ -113,7 +229,7 @@ main(int argc, char* argv[])
   {
     XMLPlatformUtils::Initialize();
     mc_hybrid::Solver solver;
-    solver.verify(filename, q_param, verbose);
+    solver.verify(filename, opts);
     XMLPlatformUtils::Terminate();
   }
   catch (const exception& e)
@@ -9,147 +9,706 @@
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <map>
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
 
 #include "types.hpp"
 #include "variable.hpp"
 #include "constraint.hpp"
 #include "problem.hpp"
+#include "cnf.hpp"
 #include "minisat_helpers.hpp"
+#include "options.hpp"
 #include "paths.hpp"
 
 using std::string;
-using std::ostringstream;
 using std::fstream;
 using std::endl;
 using std::ios;
 using std::remove;
 using std::runtime_error;
 using std::vector;
+using std::ostringstream;
 using std::istringstream;
+using std::map;
+using std::pair;
+using std::make_pair;
+using std::sort;
+using std::reverse;
 
 namespace mc_hybrid
 {
-  size_t
+  /**
+   * @brief Exit status of minisat+ for unsatisfiable constraints.
+   */
+  const int minisat_unsat_status = 20;
+
+  /**
+   * @brief Descriptor of minisat+ end of the pipe with binary CNF.
+   */
+  const int minisat_output_fd = 3;
+
+  /**
+   * @brief Prefix of minisat+ report of tuned thresholds (on stderr).
+   */
+  const char* minisat_tune_prefix = "Tuned on ";
+
+  /**
+   * @brief Maximal number of variables of constraint made into clauses
+   * without minisat+.
+   */
+  const size_t minisat_direct_lits = 16;
+
+  /**
+   * @brief Enumerator of clauses of sum of weighted literals at least bound.
+   */
+  class Threshold_clauses
+  {
+    public:
+      /**
+       * @brief Constructor.
+       *
+       * @param[in] terms Positive weights and literals.
+       * @param[in] bound Bound of sum.
+       */
+      Threshold_clauses(const vector<pair<int_t, int> >& terms,
+                        const int_t& bound) :
+        terms(terms),
+        bound(bound),
+        rest(terms.size() + 1),
+        taken(terms.size(), false),
+        clauses(0),
+        limit(0)
+      {
+        // Heaviest literals are tried first, so the last one left out is
+        // the lightest.
+        sort(this->terms.begin(), this->terms.end());
+        reverse(this->terms.begin(), this->terms.end());
+        for (size_t i = terms.size(); i > 0; --i)
+          rest[i - 1] = rest[i] + this->terms[i - 1].first;
+      }
+
+      /**
+       * @brief Appends clauses.
+       *
+       * @param[in]     limit   Maximal number of clauses.
+       * @param[in,out] clauses Clauses.
+       *
+       * @return true if there are no more clauses than limit.
+       */
+      bool
+      make(size_t limit, vector<vector<int> >& clauses)
+      {
+        this->clauses = &clauses;
+        this->limit = clauses.size() + limit;
+        return step(0, 0, terms.size());
+      }
+
+    private:
+      /**
+       * @brief Chooses whether literal i is in the set of true literals.
+       *
+       * @param[in] i    Literal index.
+       * @param[in] sum  Sum of weights of literals taken before i.
+       * @param[in] left Index of the last literal left out before i (size of
+       *                 terms if there is none).
+       *
+       * @return false if limit is exceeded.
+       */
+      bool
+      step(size_t i, const int_t& sum, size_t left)
+      {
+        if (i == terms.size())
+        {
+          // Set must not reach bound and be maximal.
+          if (sum >= bound ||
+              (left < terms.size() && sum + terms[left].first < bound))
+            return true;
+          if (clauses->size() == limit)
+            return false;
+          vector<int> clause;
+          for (size_t j = 0; j < terms.size(); ++j)
+            if (!taken[j])
+              clause.push_back(terms[j].second);
+          clauses->push_back(clause);
+          return true;
+        }
+        if (sum + terms[i].first < bound)
+        {
+          taken[i] = true;
+          bool result = step(i + 1, sum + terms[i].first, left);
+          taken[i] = false;
+          if (!result)
+            return false;
+        }
+        // Literal left out must reach bound with the taken ones.
+        if (sum + rest[i] >= bound)
+          return step(i + 1, sum, i);
+        return true;
+      }
+
+      vector<pair<int_t, int> > terms; ///< Weights and literals.
+      int_t bound;                     ///< Bound of sum.
+      vector<int_t> rest;              ///< Sums of weights from i to end.
+      vector<bool> taken;              ///< Literals in the current set.
+      vector<vector<int> >* clauses;   ///< Clauses.
+      size_t limit;                    ///< Maximal size of clauses.
+  }; // class Threshold_clauses
+
+  /**
+   * @brief Buffered reader of varint encoded numbers from descriptor.
+   */
+  class Bcnf_reader
+  {
+    public:
+      /**
+       * @brief Constructor.
+       *
+       * @param[in] fd Descriptor.
+       */
+      Bcnf_reader(int fd) :
+        fd(fd),
+        pos(0),
+        size(0)
+      {
+      }
+
+      /**
+       * @brief Reads byte.
+       *
+       * @param[out] byte Byte.
+       *
+       * @return true if byte is read, false at the end of stream.
+       */
+      bool
+      get_byte(unsigned& byte)
+      {
+        if (pos == size)
+        {
+          ssize_t n;
+          do
+            n = read(fd, buf, sizeof(buf));
+          while (n < 0 && errno == EINTR);
+          if (n <= 0)
+            return false;
+          pos = 0;
+          size = n;
+        }
+        byte = buf[pos++];
+        return true;
+      }
+
+      /**
+       * @brief Reads number encoded as by putUInt() from minisat+.
+       *
+       * @param[out] val Number.
+       *
+       * @return true if number is read, false at the end of stream.
+       */
+      bool
+      get_uint(unsigned long long& val)
+      {
+        unsigned byte;
+        if (!get_byte(byte))
+          return false;
+        if (!(byte & 0x80))
+        {
+          val = byte;
+          return true;
+        }
+
+        // Bits 5-6 of the first byte give the number of bytes to follow,
+        // 3 means 8 bytes follow.
+        size_t follow = ((byte & 0x60) >> 5) + 1;
+        val = byte & 0x1F;
+        if (follow == 4)
+        {
+          follow = 8;
+          val = 0;
+        }
+        for (size_t i = 0; i < follow; ++i)
+        {
+          if (!get_byte(byte))
+            return false;
+          val = (val << 8) | byte;
+        }
+        return true;
+      }
+
+    private:
+      int fd;                  ///< Descriptor.
+      unsigned char buf[4096]; ///< Read buffer.
+      size_t pos;              ///< Position in buffer.
+      size_t size;             ///< Size of data in buffer.
+  }; // class Bcnf_reader
+
+  void
   minisat_launch(Problem& problem,
+                 const Options& options,
                  Problem::Constrs_group group,
-                 size_t aux_num,
-                 string& cnf)
+                 Cnf& cnf,
+                 vector<string>& tunings)
   {
-    minisat_generate_input(problem, group);
-
-    string minisat_cmd(minisat_exec_path);
-    minisat_cmd += " ";
-    minisat_cmd += minisat_input_path;
-    minisat_cmd += " -cnf=";
-    minisat_cmd += minisat_output_path;
-    minisat_cmd += " > /dev/null 2>&1";
-    int result = system(minisat_cmd.c_str());
-    if (result != 0)
+    vector<size_t> constrs;
+    for (size_t i = 0; i < problem.get_constraints_num(group); ++i)
+      constrs.push_back(i);
+    minisat_launch(problem, options, group, constrs, cnf, tunings);
+  }
+
+  void
+  minisat_launch(Problem& problem,
+                 const Options& options,
+                 Problem::Constrs_group group,
+                 const vector<size_t>& constrs,
+                 Cnf& cnf,
+                 vector<string>& tunings)
+  {
+    vector<Constrs_subset> subsets(1);
+    subsets[0].group = group;
+    subsets[0].constrs = constrs;
+    vector<Cnf> cnfs;
+    minisat_launch(problem, options, subsets, cnfs, tunings);
+    cnf.swap(cnfs[0]);
+  }
+
+  /**
+   * @brief Reads everything from descriptor.
+   *
+   * @param[in]  fd   Descriptor.
+   * @param[out] text Text read.
+   */
+  void
+  minisat_read_text(int fd, string& text)
+  {
+    char buf[4096];
+    text.clear();
+    for (;;)
+    {
+      ssize_t n = read(fd, buf, sizeof(buf));
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        break;
+      text.append(buf, n);
+    }
+  }
+
+  /**
+   * @brief Launches minisat+ for subsets of constraints.
+   *
+   * @param[in]  problem Problem.
+   * @param[in]  options Verification options, minisat+ settings are taken.
+   * @param[in]  subsets Subsets of constraints.
+   * @param[out] cnfs    Result CNF for each subset.
+   * @param[out] tunings Thresholds tuned by minisat+ are appended.
+   *
+   * @return false if constraints are trivially unsatisfiable.
+   */
+  bool
+  minisat_run(Problem& problem,
+              const Options& options,
+              const vector<Constrs_subset>& subsets,
+              vector<Cnf>& cnfs,
+              vector<string>& tunings)
+  {
+    minisat_generate_input(problem, subsets);
+
+    ostringstream output;
+    output << "-bcnf=/dev/fd/" << minisat_output_fd;
+    // Constraints are converted to circuits concurrently.
+    ostringstream threads;
+    threads << "-threads=";
+    if (options.threads > 0)
+      threads << options.threads;
+    else
+      threads << sysconf(_SC_NPROCESSORS_ONLN);
+    vector<string> args;
+    args.push_back(minisat_exec_path);
+    args.push_back(minisat_input_path);
+    // SatELite eliminates aux variables and subsumed clauses.
+    if (options.preprocess)
+      args.push_back("-S");
+    args.push_back(output.str());
+    args.push_back(threads.str());
+    // BDD and sorter thresholds are fitted to the model's constraints.
+    if (options.tune > 0)
+    {
+      ostringstream tune;
+      tune << "-tune=" << options.tune;
+      args.push_back(tune.str());
+    }
+    vector<char*> argv;
+    for (size_t i = 0; i < args.size(); ++i)
+      argv.push_back(const_cast<char*>(args[i].c_str()));
+    argv.push_back(0);
+
+    // CNF is passed through the pipe, minisat+ writes it to descriptor 3.
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+      remove(minisat_input_path);
+      throw runtime_error("Can't create pipe for minisat+.");
+    }
+    // Tuned thresholds are reported on stderr, otherwise it is discarded.
+    int err_fds[2] = { -1, -1 };
+    if (options.tune > 0 && pipe(err_fds) != 0)
+    {
+      close(fds[0]);
+      close(fds[1]);
+      remove(minisat_input_path);
+      throw runtime_error("Can't create pipe for minisat+.");
+    }
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      close(fds[0]);
+      close(fds[1]);
+      if (err_fds[0] >= 0)
+      {
+        close(err_fds[0]);
+        close(err_fds[1]);
+      }
+      remove(minisat_input_path);
       throw runtime_error("Minisat+ can't be launched");
+    }
+    if (pid == 0)
+    {
+      if (fds[0] != minisat_output_fd)
+        close(fds[0]);
+      if (fds[1] != minisat_output_fd)
+      {
+        dup2(fds[1], minisat_output_fd);
+        close(fds[1]);
+      }
+      int null_fd = open("/dev/null", O_WRONLY);
+      if (null_fd >= 0)
+      {
+        dup2(null_fd, STDOUT_FILENO);
+        if (err_fds[1] < 0)
+          dup2(null_fd, STDERR_FILENO);
+        close(null_fd);
+      }
+      if (err_fds[1] >= 0)
+      {
+        close(err_fds[0]);
+        dup2(err_fds[1], STDERR_FILENO);
+        close(err_fds[1]);
+      }
+      execv(minisat_exec_path, &argv[0]);
+      _exit(127);
+    }
+
+    close(fds[1]);
+    if (err_fds[1] >= 0)
+      close(err_fds[1]);
+    bool complete = minisat_read_cnf(fds[0], cnfs);
+    close(fds[0]);
+    if (err_fds[0] >= 0)
+    {
+      string errors;
+      minisat_read_text(err_fds[0], errors);
+      close(err_fds[0]);
+      istringstream lines(errors);
+      string line;
+      while (getline(lines, line))
+        if (line.compare(0, strlen(minisat_tune_prefix), minisat_tune_prefix) == 0)
+          tunings.push_back(line);
+    }
+    int result;
+    while (waitpid(pid, &result, 0) < 0)
+      if (errno != EINTR)
+      {
+        result = -1;
+        break;
+      }
     remove(minisat_input_path);
 
-    size_t new_aux_num = minisat_read_output(aux_num, cnf);
+    if (result != -1 && WIFEXITED(result) &&
+        WEXITSTATUS(result) == minisat_unsat_status)
+      return false;
+    if (result != 0)
+      throw runtime_error("Minisat+ can't be launched");
+    if (!complete)
+      throw runtime_error("Minisat+ output is corrupted.");
+    return true;
+  }
+
+  void
+  minisat_launch(Problem& problem,
+                 const Options& options,
+                 const vector<Constrs_subset>& subsets,
+                 vector<Cnf>& cnfs,
+                 vector<string>& tunings)
+  {
+    cnfs.assign(subsets.size(), Cnf());
+
+    // Constraints over few variables are made into clauses here, the others
+    // are left to minisat+. Variables of the former are numbered by
+    // direct_idxs.
+    vector<Constrs_subset> rest(subsets.size());
+    vector<vector<vector<int> > > direct(subsets.size());
+    vector<string> direct_names;
+    map<string, size_t> direct_idxs;
+    size_t rest_num = 0;
+    size_t direct_num = 0;
+    vector<string> names;
+    vector<vector<int> > clauses;
+    for (size_t k = 0; k < subsets.size(); ++k)
+    {
+      Problem::Constrs_group group = subsets[k].group;
+      rest[k].group = group;
+      for (size_t i = 0; i < subsets[k].constrs.size(); ++i)
+      {
+        size_t constr = subsets[k].constrs[i];
+        if (!minisat_direct_clauses(problem, group, constr, names, clauses))
+        {
+          rest[k].constrs.push_back(constr);
+          ++rest_num;
+          continue;
+        }
+        for (size_t j = 0; j < clauses.size(); ++j)
+        {
+          vector<int>& clause = clauses[j];
+          for (size_t l = 0; l < clause.size(); ++l)
+          {
+            const string& name = names[abs(clause[l]) - 1];
+            map<string, size_t>::iterator iter = direct_idxs.find(name);
+            if (iter == direct_idxs.end())
+            {
+              iter = direct_idxs.insert(
+                make_pair(name, direct_names.size())).first;
+              direct_names.push_back(name);
+            }
+            int var = int(iter->second + 1);
+            clause[l] = (clause[l] > 0) ? var : -var;
+          }
+          direct[k].push_back(clause);
+        }
+        direct_num += clauses.size();
+      }
+    }
+
+    if (rest_num > 0 && !minisat_run(problem, options, rest, cnfs, tunings))
+    {
+      // Trivially unsatisfiable constraints, nothing is written.
+      for (size_t i = 0; i < cnfs.size(); ++i)
+      {
+        cnfs[i].clear();
+        cnfs[i].add_clause(vector<int>());
+      }
+      return;
+    }
+    if (direct_num == 0)
+      return;
+
+    // Names of minisat+ (the same in all cnfs) are kept, the other
+    // variables of direct clauses are named after them and aux variables
+    // are shifted by the same number in all cnfs.
+    size_t names_num = cnfs[0].get_names_num();
+    map<string, size_t> idxs;
+    for (size_t i = 0; i < names_num; ++i)
+      idxs[cnfs[0].get_name(i)] = i + 1;
+    vector<string> extra;
+    vector<int> direct_vars(direct_names.size());
+    for (size_t i = 0; i < direct_names.size(); ++i)
+    {
+      map<string, size_t>::iterator iter = idxs.find(direct_names[i]);
+      if (iter != idxs.end())
+        direct_vars[i] = int(iter->second);
+      else
+      {
+        extra.push_back(direct_names[i]);
+        direct_vars[i] = int(names_num + extra.size());
+      }
+    }
+    for (size_t k = 0; k < cnfs.size(); ++k)
+    {
+      Cnf cnf;
+      for (size_t i = 0; i < names_num; ++i)
+        cnf.add_name(cnfs[k].get_name(i));
+      for (size_t i = 0; i < extra.size(); ++i)
+        cnf.add_name(extra[i]);
+
+      const vector<int>& lits = cnfs[k].get_lits();
+      vector<int> clause;
+      for (size_t i = 0; i < lits.size(); ++i)
+      {
+        if (lits[i] == 0)
+        {
+          cnf.add_clause(clause);
+          clause.clear();
+          continue;
+        }
+        size_t var = abs(lits[i]);
+        if (var > names_num)
+          var += extra.size();
+        clause.push_back((lits[i] > 0) ? int(var) : -int(var));
+      }
+      for (size_t j = 0; j < direct[k].size(); ++j)
+      {
+        clause.clear();
+        for (size_t l = 0; l < direct[k][j].size(); ++l)
+        {
+          int lit = direct[k][j][l];
+          int var = direct_vars[abs(lit) - 1];
+          clause.push_back((lit > 0) ? var : -var);
+        }
+        cnf.add_clause(clause);
+      }
+      cnfs[k].swap(cnf);
+    }
+  }
 
-    remove(minisat_output_path);
+  bool
+  minisat_direct_clauses(Problem& problem,
+                         Problem::Constrs_group group,
+                         size_t constr,
+                         vector<string>& names,
+                         vector<vector<int> >& clauses)
+  {
+    names.clear();
+    clauses.clear();
+    Constraint& c = problem.get_constraint(group, constr);
+    vector<int_t> coeffs;
+    for (size_t j = 0; j < problem.get_constraints_vars_num(group); ++j)
+    {
+      Variable& v = problem.get_constraints_var(group, j);
+      real_t coeff = c.get_coeff(v);
+      if (coeff == 0)
+        continue;
+      if (coeff.get_den() != 1 || names.size() == minisat_direct_lits)
+        return false;
+      names.push_back(v.get_name());
+      coeffs.push_back(coeff.get_num());
+    }
+    real_t free_member = c.get_free_member();
+    if (free_member.get_den() != 1)
+      return false;
 
-    return new_aux_num;
+    // Sum of coeffs is at least -free_member (and at most for equation).
+    // Negative coeff c of x is weight -c of !x, bound is increased by -c.
+    size_t sides = (c.get_type() == Constraint::EQUAL) ? 2 : 1;
+    for (size_t k = 0; k < sides; ++k)
+    {
+      int sign = (k == 0) ? 1 : -1;
+      int_t bound = -sign * free_member.get_num();
+      vector<pair<int_t, int> > terms;
+      for (size_t i = 0; i < coeffs.size(); ++i)
+      {
+        int_t weight = sign * coeffs[i];
+        int lit = int(i + 1);
+        if (weight < 0)
+        {
+          bound -= weight;
+          weight = -weight;
+          lit = -lit;
+        }
+        terms.push_back(make_pair(weight, lit));
+      }
+      Threshold_clauses threshold(terms, bound);
+      if (!threshold.make(std::max<size_t>(names.size(), 1), clauses))
+        return false;
+    }
+    return true;
   }
 
   void
   minisat_generate_input(Problem& problem,
-                         Problem::Constrs_group group)
+                         const vector<Constrs_subset>& subsets)
   {
     fstream file(minisat_input_path, ios::out | ios::trunc);
     if (!file)
       throw runtime_error("Can't create minisat+ input file.");
 
-    for (size_t i = 0; i < problem.get_constraints_num(group); ++i)
+    for (size_t k = 0; k < subsets.size(); ++k)
     {
-      Constraint& c = problem.get_constraint(group, i);
-      for (size_t j = 0; j < problem.get_constraints_vars_num(group); ++j)
+      if (subsets.size() > 1)
+        file << "* #group" << endl;
+      Problem::Constrs_group group = subsets[k].group;
+      const vector<size_t>& constrs = subsets[k].constrs;
+      for (size_t i = 0; i < constrs.size(); ++i)
       {
-        Variable& v = problem.get_constraints_var(group, j);
-        real_t coeff = c.get_coeff(v);
-        if (coeff != 0)
-          file << coeff << "*" << v.get_name() << " ";
+        Constraint& c = problem.get_constraint(group, constrs[i]);
+        for (size_t j = 0; j < problem.get_constraints_vars_num(group); ++j)
+        {
+          Variable& v = problem.get_constraints_var(group, j);
+          real_t coeff = c.get_coeff(v);
+          if (coeff != 0)
+            file << coeff << "*" << v.get_name() << " ";
+        }
+        if (c.get_type() == Constraint::EQUAL)
+          file << "= ";
+        else
+          file << ">= ";
+        file << -1 * c.get_free_member() << ";" << endl;
       }
-      file << ">= " << -1 * c.get_free_member() << ";" << endl;
     }
   }
 
-  size_t
-  minisat_read_output(size_t aux_num,
-                      string& cnf)
+  bool
+  minisat_read_cnf(int fd, vector<Cnf>& cnfs)
   {
-    fstream file(minisat_output_path, ios::in);
-    if (!file)
-      throw runtime_error("Minisat+ output file doesn't exist.");
-
-    // Read vars and clauses num.
-    size_t vars_num;
-    file >> vars_num;
-    size_t clauses_num;
-    file >> clauses_num;
-    if (clauses_num > 0)
+    Bcnf_reader reader(fd);
+
+    for (size_t k = 0; k < cnfs.size(); ++k)
     {
-      file.ignore();
-      // read names
-      vector<string> index2name;
-      string names;
-      getline(file, names);
-      istringstream iss(names);
+      Cnf& cnf = cnfs[k];
+      cnf.clear();
+
+      // Read vars and clauses num. Vars num is not used: aux variables are
+      // counted by the literals actually met in clauses.
+      unsigned long long vars_num;
+      unsigned long long clauses_num;
+      unsigned long long names_num;
+      if (!reader.get_uint(vars_num) ||
+          !reader.get_uint(clauses_num) ||
+          !reader.get_uint(names_num))
+        return false;
+
+      // Read names, i-th name is the name of variable i + 1.
       string name;
-      while (iss >> name)
+      for (unsigned long long i = 0; i < names_num; ++i)
       {
-        // replace ' with next()
-        if (name[name.length() - 1] == '\'')
+        unsigned long long len;
+        if (!reader.get_uint(len))
+          return false;
+        name.resize(len);
+        for (unsigned long long j = 0; j < len; ++j)
         {
-          name.erase(name.length() - 1);
-          name = "next(" + name + ")";
+          unsigned byte;
+          if (!reader.get_byte(byte))
+            return false;
+          name[j] = char(byte);
         }
-        index2name.push_back(name);
+        cnf.add_name(name);
       }
-      size_t orig_number = index2name.size();
 
-      // Add enough num of aux vars to index2name.
-      size_t aux_index = aux_num;
-      for (size_t i = orig_number; i < vars_num; ++i)
+      // Read clauses, each one is terminated by 0.
+      vector<int> clause;
+      for (unsigned long long i = 0; i < clauses_num; ++i)
       {
-        ostringstream oss;
-        oss << "_aux" << aux_index;
-        index2name.push_back(oss.str());
-        ++aux_index;
-      }
-
-      // Read clauses.
-      ostringstream oss_result;
-      string clause;
-      while (getline(file, clause))
-      {
-        istringstream iss(clause);
-        oss_result << "(";
-        int var_index;
-        while (iss >> var_index)
+        unsigned long long lit;
+        clause.clear();
+        for (;;)
         {
-          if (var_index < 0)
-          {
-            oss_result << "!";
-            var_index *= -1;
-          }
-          oss_result << index2name.at(var_index);
-          oss_result << " | ";
+          if (!reader.get_uint(lit))
+            return false;
+          if (lit == 0)
+            break;
+          int var = int(lit >> 1);
+          clause.push_back((lit & 1) ? -var : var);
         }
-        oss_result.seekp(-3, ios::end);
-        oss_result << ") & ";
+        cnf.add_clause(clause);
       }
-      cnf = oss_result.str();
-      cnf.erase(cnf.length() - 3);
-      return aux_index;
-    }
-    else
-    {
-      cnf = "";
-      return 0;
     }
+
+    return true;
   }
 }; // namespace mc_hybrid
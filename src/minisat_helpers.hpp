@@ -9,46 +9,150 @@
 #define MINISAT_HELPERS_HPP_
 
 #include <string>
+#include <vector>
 
 namespace mc_hybrid
 {
+  class Cnf;
+  struct Options;
+
+  /**
+   * @brief Subset of constraints group.
+   */
+  struct Constrs_subset
+  {
+    Problem::Constrs_group group; ///< Constraints group.
+    std::vector<size_t> constrs;  ///< Indices of constraints in the group.
+  }; // struct Constrs_subset
+
   /**
    * @brief Makes cnf equisatisfiable to system of pb constraints.
    *
+   * If constraints are trivially unsatisfiable, cnf contains empty clause.
+   *
    * @param[in]  problem Problem.
+   * @param[in]  options Verification options, minisat+ settings are taken.
    * @param[in]  group   Constraints group.
-   * @param[in]  aux_num Aux vars number.
-   * @param[out] cnf     Result string with CNF.
+   * @param[out] cnf     Result CNF.
+   * @param[out] tunings Thresholds tuned by minisat+ are appended.
+   */
+  void
+  minisat_launch(Problem& problem,
+                 const Options& options,
+                 Problem::Constrs_group group,
+                 Cnf& cnf,
+                 std::vector<std::string>& tunings);
+
+  /**
+   * @brief Makes cnf equisatisfiable to subset of constraints group.
+   *
+   * If constraints are trivially unsatisfiable, cnf contains empty clause.
    *
-   * @return New aux vars number.
+   * @param[in]  problem Problem.
+   * @param[in]  options Verification options, minisat+ settings are taken.
+   * @param[in]  group   Constraints group.
+   * @param[in]  constrs Indices of constraints in the group.
+   * @param[out] cnf     Result CNF.
+   * @param[out] tunings Thresholds tuned by minisat+ are appended.
    */
-  size_t
+  void
   minisat_launch(Problem& problem,
+                 const Options& options,
                  Problem::Constrs_group group,
-                 size_t aux_num,
-                 std::string& cnf);
+                 const std::vector<size_t>& constrs,
+                 Cnf& cnf,
+                 std::vector<std::string>& tunings);
 
   /**
-   * @brief Makes input file for minisat+.
+   * @brief Makes cnfs equisatisfiable to several subsets of constraints.
+   *
+   * All subsets are encoded by one minisat+ run in the same formula
+   * environment, so common subformulas are encoded once and get the same
+   * aux variables in all cnfs: aux variables are numbered the same way in
+   * all cnfs. Each cnf defines all aux variables it contains, so it is
+   * equisatisfiable to its subset on its own.
+   *
+   * If constraints of a subset are trivially unsatisfiable, its cnf
+   * contains empty clause.
+   *
+   * Constraints over few variables (single variable bounds) are made into
+   * clauses directly (see minisat_direct_clauses()), minisat+ isn't
+   * launched if there are no others. Variables of such constraints which
+   * minisat+ doesn't name are named after its ones, so numbering of aux
+   * variables is still the same in all cnfs.
+   *
+   * If tuning is enabled by options, minisat+ fits thresholds of its mixed
+   * encoding to a sample of constraints, its report of the fitted values
+   * is appended to tunings.
+   *
+   * @param[in]  problem Problem.
+   * @param[in]  options Verification options, minisat+ settings are taken.
+   * @param[in]  subsets Subsets of constraints.
+   * @param[out] cnfs    Result CNF for each subset.
+   * @param[out] tunings Thresholds tuned by minisat+ are appended.
+   */
+  void
+  minisat_launch(Problem& problem,
+                 const Options& options,
+                 const std::vector<Constrs_subset>& subsets,
+                 std::vector<Cnf>& cnfs,
+                 std::vector<std::string>& tunings);
+
+  /**
+   * @brief Makes clauses of constraint over few variables directly.
+   *
+   * Constraint with at most minisat_direct_lits variables is written as
+   * sum of positive weights of literals at least bound (an equation as two
+   * such inequalities), each maximal set of literals which are true and
+   * don't reach the bound gives the clause of the others. For bits of one
+   * variable it is the comparator with the bound, no aux variables are
+   * needed. Constraint with more clauses than literals (per inequality) is
+   * left to minisat+.
    *
    * @param[in]  problem Problem.
    * @param[in]  group   Constraints group.
+   * @param[in]  constr  Index of constraint in the group.
+   * @param[out] names   Names of variables, i-th one is variable i + 1.
+   * @param[out] clauses Clauses, empty clause if constraint is false.
+   *
+   * @return true if constraint is made into clauses.
+   */
+  bool
+  minisat_direct_clauses(Problem& problem,
+                         Problem::Constrs_group group,
+                         size_t constr,
+                         std::vector<std::string>& names,
+                         std::vector<std::vector<int> >& clauses);
+
+  /**
+   * @brief Makes input file for minisat+.
+   *
+   * If there are several subsets, each one is preceded by "* #group"
+   * comment, so minisat+ encodes them separately.
+   *
+   * @param[in]  problem Problem.
+   * @param[in]  subsets Subsets of constraints.
    */
   void
   minisat_generate_input(Problem& problem,
-                         Problem::Constrs_group group);
+                         const std::vector<Constrs_subset>& subsets);
 
   /**
-   * @brief Reads minisat output file.
+   * @brief Reads binary CNFs written by minisat+ (-bcnf option).
+   *
+   * Numbers are varint encoded as by putUInt() from minisat+ ADTs. Every
+   * CNF consists of variables number, clauses number, names number, names
+   * (length and characters), then clauses of literals 2 * var + sign
+   * terminated by 0. CNFs of groups follow one another.
    *
-   * @param[in]  aux_num Aux vars number.
-   * @param[out] cnf     Result string with CNF.
+   * @param[in]  fd   Descriptor to read from (pipe from minisat+).
+   * @param[out] cnfs Result CNFs, as many as there are elements.
    *
-   * @return New aux vars number.
+   * @return true if all CNFs are read, false if stream is empty or
+   * @return truncated.
    */
-  size_t
-  minisat_read_output(size_t aux_num,
-                      std::string& cnf);
+  bool
+  minisat_read_cnf(int fd, std::vector<Cnf>& cnfs);
 }; // namespace mc_hybrid
 
 #endif // #ifndef MINISAT_HELPERS_HPP_
@@ -0,0 +1,513 @@
+/**
+ * @file model_bdd.cpp
+ * @brief Model_bdd class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <stdexcept>
+#include <map>
+#include <algorithm>
+
+#include "types.hpp"
+#include "model_bdd.hpp"
+#include "counterexample.hpp"
+#include "variable.hpp"
+#include "constraint.hpp"
+#include "problem.hpp"
+
+using std::string;
+using std::runtime_error;
+using std::logic_error;
+using std::vector;
+using std::map;
+using std::pair;
+using std::make_pair;
+using std::sort;
+using std::reverse;
+
+namespace mc_hybrid
+{
+  Model_bdd::Model_bdd(Problem& problem, bool backward) :
+    problem(problem),
+    backward(backward)
+  {
+    manager = Cudd_Init(0, 0, CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0);
+    if (manager == 0)
+      throw runtime_error("Can't initialize CUDD manager.");
+
+    // Create variables in the tool's order.
+    bdd_vars.assign(problem.get_variables_num(), 0);
+    for (size_t i = 0; i < problem.get_variables_num(Problem::VARS_INPUT); ++i)
+    {
+      DdNode* v = Cudd_bddNewVar(manager);
+      bdd_input.push_back(v);
+      bdd_vars[problem.get_variable_idx(Problem::VARS_INPUT, i)] = v;
+    }
+    map<string, size_t> next_idxs;
+    for (size_t i = 0; i < problem.get_variables_num(Problem::VARS_NEXT_STATE); ++i)
+    {
+      Variable& v = problem.get_variable(Problem::VARS_NEXT_STATE, i);
+      next_idxs[v.get_name()] = problem.get_variable_idx(Problem::VARS_NEXT_STATE, i);
+    }
+    for (size_t i = 0; i < problem.get_variables_num(Problem::VARS_STATE); ++i)
+    {
+      Variable& v = problem.get_variable(Problem::VARS_STATE, i);
+      map<string, size_t>::iterator iter = next_idxs.find(v.get_name() + "'");
+      if (iter == next_idxs.end())
+        throw logic_error("Next state variable is missing while creating BDD model.");
+      DdNode* v_state = Cudd_bddNewVar(manager);
+      DdNode* v_next = Cudd_bddNewVar(manager);
+      bdd_state.push_back(v_state);
+      bdd_next.push_back(v_next);
+      bdd_vars[problem.get_variable_idx(Problem::VARS_STATE, i)] = v_state;
+      bdd_vars[iter->second] = v_next;
+    }
+
+    init = Cudd_ReadOne(manager);
+    Cudd_Ref(init);
+    for (size_t i = 0; i < problem.get_constraints_num(Problem::CONSTRS_INIT); ++i)
+    {
+      DdNode* c = build_constraint(problem.get_constraint(Problem::CONSTRS_INIT, i));
+      DdNode* tmp = Cudd_bddAnd(manager, init, c);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, init);
+      Cudd_RecursiveDeref(manager, c);
+      init = tmp;
+    }
+
+    build_trans();
+
+    if (problem.get_constraints_num(Problem::CONSTRS_SPEC) == 0)
+      throw logic_error("Specification is empty while creating BDD model.");
+    spec = Cudd_ReadOne(manager);
+    Cudd_Ref(spec);
+    for (size_t i = 0; i < problem.get_constraints_num(Problem::CONSTRS_SPEC); ++i)
+    {
+      DdNode* c = build_constraint(problem.get_constraint(Problem::CONSTRS_SPEC, i));
+      DdNode* tmp = Cudd_bddAnd(manager, spec, c);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, spec);
+      Cudd_RecursiveDeref(manager, c);
+      spec = tmp;
+    }
+
+    vector<DdNode*> vars(bdd_input);
+    vars.insert(vars.end(), bdd_state.begin(), bdd_state.end());
+    image_cube = build_schedule(vars, image_schedule);
+    vars.assign(bdd_input.begin(), bdd_input.end());
+    vars.insert(vars.end(), bdd_next.begin(), bdd_next.end());
+    preimage_cube = build_schedule(vars, preimage_schedule);
+  }
+
+  Model_bdd::~Model_bdd()
+  {
+    Cudd_RecursiveDeref(manager, init);
+    deref(trans);
+    Cudd_RecursiveDeref(manager, spec);
+    Cudd_RecursiveDeref(manager, image_cube);
+    deref(image_schedule);
+    Cudd_RecursiveDeref(manager, preimage_cube);
+    deref(preimage_schedule);
+    Cudd_Quit(manager);
+  }
+
+  DdNode*
+  Model_bdd::build_constraint(Constraint& c)
+  {
+    // Terms sorted by levels of their variables.
+    vector<pair<int, size_t> > order;
+    for (size_t i = 0; i < problem.get_variables_num(); ++i)
+      if (c.get_coeff(problem.get_variable(i)) != 0)
+        order.push_back(make_pair(Cudd_ReadPerm(manager, Cudd_NodeReadIndex(bdd_vars[i])), i));
+    sort(order.begin(), order.end());
+
+    size_t terms_num = order.size();
+    vector<real_t> coeffs(terms_num);
+    vector<real_t> rest_min(terms_num + 1, 0);
+    vector<real_t> rest_max(terms_num + 1, 0);
+    for (size_t i = terms_num; i > 0; --i)
+    {
+      coeffs[i - 1] = c.get_coeff(problem.get_variable(order[i - 1].second));
+      rest_min[i - 1] = rest_min[i] + (coeffs[i - 1] < 0 ? coeffs[i - 1] : real_t(0));
+      rest_max[i - 1] = rest_max[i] + (coeffs[i - 1] > 0 ? coeffs[i - 1] : real_t(0));
+    }
+    bool equal = (c.get_type() == Constraint::EQUAL);
+
+    // Partial sums reachable at each level.
+    vector<map<real_t, DdNode*> > nodes(terms_num + 1);
+    nodes[0][c.get_free_member()] = 0;
+    for (size_t i = 0; i < terms_num; ++i)
+    {
+      map<real_t, DdNode*>::iterator iter;
+      for (iter = nodes[i].begin(); iter != nodes[i].end(); ++iter)
+      {
+        const real_t& sum = iter->first;
+        if (terminal(sum + rest_min[i], sum + rest_max[i], equal) != 0)
+          continue;
+        nodes[i + 1][sum] = 0;
+        nodes[i + 1][sum + coeffs[i]] = 0;
+      }
+    }
+
+    // Build nodes bottom-up.
+    for (size_t i = terms_num + 1; i > 0; --i)
+    {
+      size_t level = i - 1;
+      map<real_t, DdNode*>::iterator iter;
+      for (iter = nodes[level].begin(); iter != nodes[level].end(); ++iter)
+      {
+        const real_t& sum = iter->first;
+        DdNode* node = terminal(sum + rest_min[level], sum + rest_max[level], equal);
+        if (node == 0)
+        {
+          DdNode* hi = nodes[level + 1][sum + coeffs[level]];
+          DdNode* lo = nodes[level + 1][sum];
+          node = Cudd_bddIte(manager, bdd_vars[order[level].second], hi, lo);
+        }
+        Cudd_Ref(node);
+        iter->second = node;
+      }
+      if (level < terms_num)
+      {
+        for (iter = nodes[level + 1].begin(); iter != nodes[level + 1].end(); ++iter)
+          Cudd_RecursiveDeref(manager, iter->second);
+        nodes[level + 1].clear();
+      }
+    }
+
+    return nodes[0].begin()->second;
+  }
+
+  DdNode*
+  Model_bdd::terminal(const real_t& lo, const real_t& hi, bool equal)
+  {
+    if (equal)
+    {
+      if (lo > 0 || hi < 0)
+        return Cudd_ReadLogicZero(manager);
+      if (lo == 0 && hi == 0)
+        return Cudd_ReadOne(manager);
+    }
+    else
+    {
+      if (lo >= 0)
+        return Cudd_ReadOne(manager);
+      if (hi < 0)
+        return Cudd_ReadLogicZero(manager);
+    }
+    return 0;
+  }
+
+  void
+  Model_bdd::build_trans()
+  {
+    size_t constrs_num = problem.get_constraints_num(Problem::CONSTRS_TRANS);
+    size_t vars_num = bdd_next.size();
+
+    vector<DdNode*> constrs(constrs_num);
+    for (size_t i = 0; i < constrs_num; ++i)
+      constrs[i] = build_constraint(problem.get_constraint(Problem::CONSTRS_TRANS, i));
+
+    // Union-find over constraints: constraints are joined by next state
+    // variables they share.
+    vector<size_t> parent(constrs_num);
+    for (size_t i = 0; i < constrs_num; ++i)
+      parent[i] = i;
+    vector<size_t> owner(vars_num, constrs_num);
+    vector<bool> has_next(constrs_num, false);
+    for (size_t i = 0; i < constrs_num; ++i)
+    {
+      DdNode* support = Cudd_Support(manager, constrs[i]);
+      Cudd_Ref(support);
+      for (size_t j = 0; j < vars_num; ++j)
+      {
+        if (!Cudd_bddLeq(manager, support, bdd_next[j]))
+          continue;
+        has_next[i] = true;
+        if (owner[j] == constrs_num)
+        {
+          owner[j] = i;
+          continue;
+        }
+        size_t a = i;
+        while (parent[a] != a)
+          a = parent[a];
+        size_t b = owner[j];
+        while (parent[b] != b)
+          b = parent[b];
+        if (a != b)
+          parent[a < b ? b : a] = a < b ? a : b;
+      }
+      Cudd_RecursiveDeref(manager, support);
+    }
+
+    // Conjoin constraints of each partition, constraints without next state
+    // variables form the last one.
+    vector<size_t> partition_idx(constrs_num, constrs_num);
+    DdNode* rest = 0;
+    for (size_t i = 0; i < constrs_num; ++i)
+    {
+      DdNode** partition = &rest;
+      if (has_next[i])
+      {
+        size_t root = i;
+        while (parent[root] != root)
+          root = parent[root];
+        if (partition_idx[root] == constrs_num)
+        {
+          partition_idx[root] = trans.size();
+          trans.push_back(0);
+        }
+        partition = &trans[partition_idx[root]];
+      }
+      if (*partition == 0)
+        *partition = constrs[i];
+      else
+      {
+        DdNode* tmp = Cudd_bddAnd(manager, *partition, constrs[i]);
+        Cudd_Ref(tmp);
+        Cudd_RecursiveDeref(manager, *partition);
+        Cudd_RecursiveDeref(manager, constrs[i]);
+        *partition = tmp;
+      }
+    }
+    if (rest != 0)
+      trans.push_back(rest);
+  }
+
+  DdNode*
+  Model_bdd::build_schedule(const vector<DdNode*>& vars,
+                            vector<DdNode*>& schedule)
+  {
+    vector<DdNode*> supports(trans.size());
+    for (size_t i = 0; i < trans.size(); ++i)
+    {
+      supports[i] = Cudd_Support(manager, trans[i]);
+      Cudd_Ref(supports[i]);
+    }
+
+    DdNode* cube = Cudd_ReadOne(manager);
+    Cudd_Ref(cube);
+    schedule.assign(trans.size(), cube);
+    for (size_t i = 0; i < trans.size(); ++i)
+      Cudd_Ref(cube);
+
+    for (size_t i = 0; i < vars.size(); ++i)
+    {
+      // Find the last partition depending on the variable.
+      DdNode** target = &cube;
+      for (size_t j = trans.size(); j > 0; --j)
+        if (Cudd_bddLeq(manager, supports[j - 1], vars[i]))
+        {
+          target = &schedule[j - 1];
+          break;
+        }
+      DdNode* tmp = Cudd_bddAnd(manager, *target, vars[i]);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, *target);
+      *target = tmp;
+    }
+
+    deref(supports);
+
+    return cube;
+  }
+
+  DdNode*
+  Model_bdd::image(DdNode* states)
+  {
+    DdNode* result = Cudd_bddExistAbstract(manager, states, image_cube);
+    Cudd_Ref(result);
+    for (size_t i = 0; i < trans.size(); ++i)
+    {
+      DdNode* tmp = Cudd_bddAndAbstract(manager, result, trans[i], image_schedule[i]);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, result);
+      result = tmp;
+    }
+
+    if (bdd_state.size() > 0)
+    {
+      DdNode* tmp = Cudd_bddSwapVariables(manager, result,
+                                          &bdd_state[0], &bdd_next[0],
+                                          bdd_state.size());
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, result);
+      result = tmp;
+    }
+
+    return result;
+  }
+
+  DdNode*
+  Model_bdd::preimage(DdNode* states)
+  {
+    DdNode* result = states;
+    Cudd_Ref(result);
+    if (bdd_state.size() > 0)
+    {
+      DdNode* tmp = Cudd_bddSwapVariables(manager, result,
+                                          &bdd_state[0], &bdd_next[0],
+                                          bdd_state.size());
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, result);
+      result = tmp;
+    }
+
+    DdNode* tmp = Cudd_bddExistAbstract(manager, result, preimage_cube);
+    Cudd_Ref(tmp);
+    Cudd_RecursiveDeref(manager, result);
+    result = tmp;
+    for (size_t i = 0; i < trans.size(); ++i)
+    {
+      tmp = Cudd_bddAndAbstract(manager, result, trans[i], preimage_schedule[i]);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, result);
+      result = tmp;
+    }
+
+    return result;
+  }
+
+  DdNode*
+  Model_bdd::pick_state(DdNode* states)
+  {
+    DdNode* result = Cudd_bddPickOneMinterm(manager, states,
+                                            &bdd_state[0], bdd_state.size());
+    if (result == 0)
+      throw runtime_error("Can't pick state from BDD.");
+    Cudd_Ref(result);
+
+    return result;
+  }
+
+  void
+  Model_bdd::fill_counterexample(const vector<DdNode*>& path,
+                                 Counterexample& ce)
+  {
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+      ce.add_step();
+      for (size_t j = 0; j < bdd_state.size(); ++j)
+      {
+        Variable& v = problem.get_variable(Problem::VARS_STATE, j);
+        ce.set_var_value(i, v.get_name(),
+                         Cudd_bddLeq(manager, path[i], bdd_state[j]) ? 1 : 0);
+      }
+
+      if (i + 1 == path.size() || bdd_input.size() == 0)
+        continue;
+
+      // Inputs leading from this state to the next one.
+      DdNode* rel = Cudd_bddSwapVariables(manager, path[i + 1],
+                                          &bdd_state[0], &bdd_next[0],
+                                          bdd_state.size());
+      Cudd_Ref(rel);
+      DdNode* tmp = Cudd_bddAnd(manager, rel, path[i]);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, rel);
+      rel = tmp;
+      for (size_t j = 0; j < trans.size(); ++j)
+      {
+        tmp = Cudd_bddAnd(manager, rel, trans[j]);
+        Cudd_Ref(tmp);
+        Cudd_RecursiveDeref(manager, rel);
+        rel = tmp;
+      }
+      DdNode* inputs = Cudd_bddPickOneMinterm(manager, rel,
+                                              &bdd_input[0], bdd_input.size());
+      if (inputs == 0)
+        throw runtime_error("Can't pick inputs from BDD.");
+      Cudd_Ref(inputs);
+      for (size_t j = 0; j < bdd_input.size(); ++j)
+      {
+        Variable& v = problem.get_variable(Problem::VARS_INPUT, j);
+        ce.set_ivar_value(i, v.get_name(),
+                          Cudd_bddLeq(manager, inputs, bdd_input[j]) ? 1 : 0);
+      }
+      Cudd_RecursiveDeref(manager, inputs);
+      Cudd_RecursiveDeref(manager, rel);
+    }
+  }
+
+  void
+  Model_bdd::deref(vector<DdNode*>& nodes)
+  {
+    for (size_t i = 0; i < nodes.size(); ++i)
+      Cudd_RecursiveDeref(manager, nodes[i]);
+    nodes.clear();
+  }
+
+  bool
+  Model_bdd::verify(Counterexample*& ce)
+  {
+    DdNode* zero = Cudd_ReadLogicZero(manager);
+    // Forward search starts from initial states looking for bad ones,
+    // backward search does the opposite.
+    DdNode* source = backward ? Cudd_Not(spec) : init;
+    DdNode* target = backward ? init : Cudd_Not(spec);
+
+    vector<DdNode*> rings;
+    DdNode* reached = source;
+    Cudd_Ref(reached);
+    rings.push_back(source);
+    Cudd_Ref(source);
+
+    DdNode* hit = 0;
+    for (;;)
+    {
+      hit = Cudd_bddAnd(manager, rings.back(), target);
+      Cudd_Ref(hit);
+      if (hit != zero)
+        break;
+      Cudd_RecursiveDeref(manager, hit);
+      hit = 0;
+
+      DdNode* next = backward ? preimage(rings.back()) : image(rings.back());
+      DdNode* frontier = Cudd_bddAnd(manager, next, Cudd_Not(reached));
+      Cudd_Ref(frontier);
+      Cudd_RecursiveDeref(manager, next);
+      if (frontier == zero)
+      {
+        Cudd_RecursiveDeref(manager, frontier);
+        break;
+      }
+      DdNode* tmp = Cudd_bddOr(manager, reached, frontier);
+      Cudd_Ref(tmp);
+      Cudd_RecursiveDeref(manager, reached);
+      reached = tmp;
+      rings.push_back(frontier);
+    }
+    Cudd_RecursiveDeref(manager, reached);
+
+    bool result = (hit == 0);
+    if (!result)
+    {
+      // Walk back through the rings.
+      vector<DdNode*> path;
+      path.push_back(pick_state(hit));
+      for (size_t i = rings.size() - 1; i > 0; --i)
+      {
+        DdNode* next = backward ? image(path.back()) : preimage(path.back());
+        DdNode* tmp = Cudd_bddAnd(manager, next, rings[i - 1]);
+        Cudd_Ref(tmp);
+        Cudd_RecursiveDeref(manager, next);
+        path.push_back(pick_state(tmp));
+        Cudd_RecursiveDeref(manager, tmp);
+      }
+      if (!backward)
+        reverse(path.begin(), path.end());
+
+      if (ce != 0)
+        delete ce;
+      ce = new Counterexample(problem);
+      fill_counterexample(path, *ce);
+
+      deref(path);
+      Cudd_RecursiveDeref(manager, hit);
+    }
+    deref(rings);
+
+    return result;
+  }
+}; // namespace mc_hybrid
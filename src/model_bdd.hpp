@@ -0,0 +1,215 @@
+/**
+ * @file model_bdd.hpp
+ * @brief Model_bdd class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef MODEL_BDD_HPP_
+#define MODEL_BDD_HPP_
+
+#include <vector>
+
+#include <cudd.h>
+
+namespace mc_hybrid
+{
+  class Problem;
+  class Constraint;
+  class Counterexample;
+
+  /**
+   * @brief OBDD model representation.
+   *
+   * Model is built directly from pseudoboolean problem using CUDD package
+   * and verified by symbolic reachability analysis without any external
+   * model checker.
+   */
+  class Model_bdd
+  {
+    public:
+      /**
+       * @brief Constructor from Problem.
+       *
+       * Variables order is the following: input variables first, then
+       * current and next copies of every state variable interleaved, in the
+       * order of the problem variables (so bits of every discrete variable
+       * are adjacent).
+       *
+       * @attention Problem must be pseudoboolean.
+       *
+       * @param[in] problem  Problem.
+       * @param[in] backward Use backward reachability if true, forward
+       *                     otherwise.
+       */
+      Model_bdd(Problem& problem, bool backward);
+
+      /**
+       * @brief Destructor.
+       *
+       * Frees all BDDs and CUDD manager.
+       */
+      ~Model_bdd();
+
+      /**
+       * @brief Verifies model by symbolic reachability analysis.
+       *
+       * Stops as soon as a reachable state violating specification is found.
+       *
+       * @param[out] ce Counterexample, it is allocated if verification fails.
+       *
+       * @return true if model fits specification, false otherwise.
+       */
+      bool
+      verify(Counterexample*& ce);
+
+    private:
+      /**
+       * @brief Builds OBDD for constraint.
+       *
+       * Terms are taken in the variables order and nodes are shared by the
+       * partial sum of already taken terms. A branch ends as soon as the
+       * bounds of the rest of the sum decide the constraint.
+       *
+       * @param[in] c Pseudoboolean constraint.
+       *
+       * @return Referenced OBDD of constraint.
+       */
+      DdNode*
+      build_constraint(Constraint& c);
+
+      /**
+       * @brief Gets terminal node decided by bounds of constraint sum.
+       *
+       * @param[in] lo    Lower bound of constraint sum.
+       * @param[in] hi    Upper bound of constraint sum.
+       * @param[in] equal Constraint is an equality.
+       *
+       * @return Constant node if bounds decide constraint, 0 otherwise.
+       */
+      DdNode*
+      terminal(const real_t& lo, const real_t& hi, bool equal);
+
+      /**
+       * @brief Splits transitional relation into partitions.
+       *
+       * Constraints are clustered by next state variables they share, in the
+       * same way as TRANS sections of SMV model.
+       */
+      void
+      build_trans();
+
+      /**
+       * @brief Builds early quantification schedule.
+       *
+       * Each variable from vars is quantified right after conjunction with
+       * the last partition depending on it.
+       *
+       * @param[in]  vars     Variables to quantify.
+       * @param[out] schedule Cubes of variables to quantify after each
+       *                      partition.
+       *
+       * @return Referenced cube of variables no partition depends on.
+       */
+      DdNode*
+      build_schedule(const std::vector<DdNode*>& vars,
+                     std::vector<DdNode*>& schedule);
+
+      /**
+       * @brief Computes image of the set of states.
+       *
+       * @param[in] states Set of states.
+       *
+       * @return Referenced set of successors.
+       */
+      DdNode*
+      image(DdNode* states);
+
+      /**
+       * @brief Computes preimage of the set of states.
+       *
+       * @param[in] states Set of states.
+       *
+       * @return Referenced set of predecessors.
+       */
+      DdNode*
+      preimage(DdNode* states);
+
+      /**
+       * @brief Picks one state from the set of states.
+       *
+       * @param[in] states Nonempty set of states.
+       *
+       * @return Referenced cube of state variables.
+       */
+      DdNode*
+      pick_state(DdNode* states);
+
+      /**
+       * @brief Builds counterexample from sequence of states.
+       *
+       * Input variables values are picked for every pair of consecutive
+       * states.
+       *
+       * @param[in]  path States (cubes) from initial to bad one.
+       * @param[out] ce   Counterexample.
+       */
+      void
+      fill_counterexample(const std::vector<DdNode*>& path,
+                          Counterexample& ce);
+
+      /**
+       * @brief Dereferences all OBDDs from array and clears it.
+       *
+       * @param[in,out] nodes OBDDs.
+       */
+      void
+      deref(std::vector<DdNode*>& nodes);
+
+    private:
+      /**
+       * @brief Pseudoboolean problem.
+       */
+      Problem& problem;
+      /**
+       * @brief Use backward reachability.
+       */
+      bool backward;
+
+      /**
+       * @brief CUDD manager.
+       */
+      DdManager* manager;
+
+      std::vector<DdNode*> bdd_input; ///< Input variables.
+      std::vector<DdNode*> bdd_state; ///< Current state variables.
+      std::vector<DdNode*> bdd_next;  ///< Next state variables.
+
+      /**
+       * @brief Mapping from problem variable index to OBDD variable.
+       */
+      std::vector<DdNode*> bdd_vars;
+
+      DdNode* init;               ///< Initial states.
+      std::vector<DdNode*> trans; ///< Partitions of transitional relation.
+      DdNode* spec;               ///< Specification.
+
+      /**
+       * @brief Cube of input and current state variables nothing depends on.
+       */
+      DdNode* image_cube;
+      /**
+       * @brief Early quantification schedule for image.
+       */
+      std::vector<DdNode*> image_schedule;
+      /**
+       * @brief Cube of input and next state variables nothing depends on.
+       */
+      DdNode* preimage_cube;
+      /**
+       * @brief Early quantification schedule for preimage.
+       */
+      std::vector<DdNode*> preimage_schedule;
+  }; // class Model_bdd
+}; // namespace mc_hybrid
+
+#endif // #ifndef MODEL_BDD_HPP_
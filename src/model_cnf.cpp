@@ -0,0 +1,252 @@
+/**
+ * @file model_cnf.cpp
+ * @brief Model_cnf class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <stdexcept>
+
+#include "types.hpp"
+#include "variable.hpp"
+#include "constraint.hpp"
+#include "problem.hpp"
+#include "counterexample.hpp"
+#include "cnf.hpp"
+#include "model_cnf.hpp"
+#include "sat_solver.hpp"
+#include "minisat_helpers.hpp"
+#include "options.hpp"
+
+using std::string;
+using std::vector;
+using std::map;
+using std::pair;
+using std::make_pair;
+using std::logic_error;
+
+namespace mc_hybrid
+{
+  Model_cnf::Model_cnf(Problem& problem, const Options& options) :
+    problem(problem)
+  {
+    for (size_t i = 0; i < problem.get_variables_num(Problem::VARS_STATE); ++i)
+    {
+      Variable& v = problem.get_variable(Problem::VARS_STATE, i);
+      refs[v.get_name()] = make_pair(FRAME_STATE, i);
+      refs[v.get_name() + "'"] = make_pair(FRAME_NEXT, i);
+    }
+    for (size_t i = 0; i < problem.get_variables_num(Problem::VARS_INPUT); ++i)
+    {
+      Variable& v = problem.get_variable(Problem::VARS_INPUT, i);
+      refs[v.get_name()] = make_pair(FRAME_INPUT, i);
+    }
+
+    minisat_launch(problem, options, Problem::CONSTRS_INIT, init, tunings);
+    minisat_launch(problem, options, Problem::CONSTRS_TRANS, trans, tunings);
+    minisat_launch(problem, options, Problem::CONSTRS_SPEC, spec, tunings);
+
+    // Negate specification constraints: not (E >= 0) is -E - 1 >= 0 and
+    // not (E = 0) is E - 1 >= 0 or -E - 1 >= 0 (coefficients are integer).
+    size_t spec_num = problem.get_constraints_num(Problem::CONSTRS_SPEC);
+    if (spec_num == 0)
+      throw logic_error("Specification is empty while creating CNF model.");
+    for (size_t i = 0; i < spec_num; ++i)
+    {
+      Constraint& c = problem.get_constraint(Problem::CONSTRS_SPEC, i);
+      for (int sign = -1; sign <= 1; sign += 2)
+      {
+        if (sign > 0 && c.get_type() != Constraint::EQUAL)
+          break;
+        Problem negation;
+        Constraint c_neg(Constraint::MORE_OR_EQUAL);
+        for (size_t j = 0; j < problem.get_variables_num(Problem::VARS_STATE); ++j)
+        {
+          Variable& v = problem.get_variable(Problem::VARS_STATE, j);
+          negation.add_variable(Problem::VARS_STATE, v);
+          if (c.get_coeff(v) != 0)
+            c_neg.set_coeff(v, sign * c.get_coeff(v));
+        }
+        c_neg.set_free_member(sign * c.get_free_member() - 1);
+        negation.add_constraint(Problem::CONSTRS_SPEC, c_neg);
+        bad.push_back(Cnf());
+        minisat_launch(negation, options, Problem::CONSTRS_SPEC, bad.back(),
+                       tunings);
+      }
+    }
+  }
+
+  Problem&
+  Model_cnf::get_problem()
+  {
+    return problem;
+  }
+
+  const vector<string>&
+  Model_cnf::get_tunings() const
+  {
+    return tunings;
+  }
+
+  vector<int>
+  Model_cnf::new_state(Sat_solver& solver)
+  {
+    vector<int> state(problem.get_variables_num(Problem::VARS_STATE));
+    for (size_t i = 0; i < state.size(); ++i)
+      state[i] = solver.new_var();
+    return state;
+  }
+
+  vector<int>
+  Model_cnf::new_input(Sat_solver& solver)
+  {
+    vector<int> input(problem.get_variables_num(Problem::VARS_INPUT));
+    for (size_t i = 0; i < input.size(); ++i)
+      input[i] = solver.new_var();
+    return input;
+  }
+
+  void
+  Model_cnf::add_init(Sat_solver& solver,
+                      const vector<int>& state,
+                      int act)
+  {
+    vector<int> none;
+    instantiate(solver, init, state, none, none, act);
+  }
+
+  void
+  Model_cnf::add_trans(Sat_solver& solver,
+                       const vector<int>& state,
+                       const vector<int>& input,
+                       const vector<int>& next,
+                       int act)
+  {
+    instantiate(solver, trans, state, input, next, act);
+  }
+
+  void
+  Model_cnf::add_spec(Sat_solver& solver,
+                      const vector<int>& state,
+                      int act)
+  {
+    vector<int> none;
+    instantiate(solver, spec, state, none, none, act);
+  }
+
+  void
+  Model_cnf::add_distinct(Sat_solver& solver,
+                          const vector<int>& state1,
+                          const vector<int>& state2)
+  {
+    // diff_i implies that i-th bits differ, at least one diff_i is true.
+    vector<int> diffs;
+    for (size_t i = 0; i < state1.size(); ++i)
+    {
+      int diff = solver.new_var();
+      vector<int> clause(3);
+      clause[0] = -diff;
+      clause[1] = state1[i];
+      clause[2] = state2[i];
+      solver.add_clause(clause);
+      clause[1] = -state1[i];
+      clause[2] = -state2[i];
+      solver.add_clause(clause);
+      diffs.push_back(diff);
+    }
+    solver.add_clause(diffs);
+  }
+
+  bool
+  Model_cnf::equal_states(const Sat_solver& solver,
+                          const vector<int>& state1,
+                          const vector<int>& state2) const
+  {
+    for (size_t i = 0; i < state1.size(); ++i)
+      if (solver.get_value(state1[i]) != solver.get_value(state2[i]))
+        return false;
+    return true;
+  }
+
+  void
+  Model_cnf::get_counterexample(const Sat_solver& solver,
+                                const vector<vector<int> >& states,
+                                const vector<vector<int> >& inputs,
+                                Counterexample*& ce)
+  {
+    if (ce != 0)
+      delete ce;
+    ce = new Counterexample(problem);
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+      ce->add_step();
+      for (size_t j = 0; j < states[i].size(); ++j)
+        ce->set_var_value(i,
+                          problem.get_variable(Problem::VARS_STATE, j).get_name(),
+                          solver.get_value(states[i][j]) ? 1 : 0);
+      if (i >= inputs.size())
+        continue;
+      for (size_t j = 0; j < inputs[i].size(); ++j)
+        ce->set_ivar_value(i,
+                           problem.get_variable(Problem::VARS_INPUT, j).get_name(),
+                           solver.get_value(inputs[i][j]) ? 1 : 0);
+    }
+  }
+
+  void
+  Model_cnf::add_bad(Sat_solver& solver,
+                     const vector<int>& state,
+                     int act)
+  {
+    vector<int> none;
+    vector<int> selectors;
+    if (act != 0)
+      selectors.push_back(-act);
+    for (size_t i = 0; i < bad.size(); ++i)
+    {
+      int selector = solver.new_var();
+      instantiate(solver, bad[i], state, none, none, selector);
+      selectors.push_back(selector);
+    }
+    solver.add_clause(selectors);
+  }
+
+  void
+  Model_cnf::instantiate(Sat_solver& solver,
+                         const Cnf& cnf,
+                         const vector<int>& state,
+                         const vector<int>& input,
+                         const vector<int>& next,
+                         int act)
+  {
+    // Solver variable for every CNF variable.
+    vector<int> vars(cnf.get_vars_num() + 1, 0);
+    for (size_t i = 0; i < cnf.get_names_num(); ++i)
+    {
+      map<string, pair<Frame, size_t> >::iterator iter =
+        refs.find(cnf.get_name(i));
+      if (iter == refs.end())
+        throw logic_error("Unknown variable name in CNF.");
+      const vector<int>& frame = (iter->second.first == FRAME_STATE) ? state :
+                                 (iter->second.first == FRAME_INPUT) ? input :
+                                 next;
+      vars[i + 1] = frame.at(iter->second.second);
+    }
+    for (size_t i = cnf.get_names_num() + 1; i < vars.size(); ++i)
+      vars[i] = solver.new_var();
+
+    const vector<int>& lits = cnf.get_lits();
+    vector<int> clause;
+    for (size_t i = 0; i < lits.size(); ++i)
+    {
+      if (lits[i] == 0)
+      {
+        if (act != 0)
+          clause.push_back(-act);
+        solver.add_clause(clause);
+        clause.clear();
+      }
+      else
+        clause.push_back(lits[i] > 0 ? vars[lits[i]] : -vars[-lits[i]]);
+    }
+  }
+}; // namespace mc_hybrid
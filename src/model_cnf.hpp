@@ -0,0 +1,232 @@
+/**
+ * @file model_cnf.hpp
+ * @brief Model_cnf class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef MODEL_CNF_HPP_
+#define MODEL_CNF_HPP_
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "cnf.hpp"
+
+namespace mc_hybrid
+{
+  class Problem;
+  class Sat_solver;
+  class Counterexample;
+  struct Options;
+
+  /**
+   * @brief CNF model representation.
+   *
+   * Keeps CNF templates of initial conditions, transitional relation,
+   * specification and its negation built by minisat+. Templates are instantiated
+   * in SAT solver for given frames: every frame is an array of solver
+   * variables for state (or input) variables of the problem, aux variables
+   * are fresh for every instance.
+   */
+  class Model_cnf
+  {
+    public:
+      /**
+       * @brief Constructor from Problem.
+       *
+       * @attention Problem must be pseudoboolean.
+       *
+       * @param[in] problem Problem.
+       * @param[in] options Verification options, minisat+ settings are taken.
+       */
+      Model_cnf(Problem& problem, const Options& options);
+
+      /**
+       * @brief Gets problem.
+       *
+       * @return Pseudoboolean problem.
+       */
+      Problem&
+      get_problem();
+
+      /**
+       * @brief Gets thresholds tuned by minisat+ while building CNFs.
+       *
+       * @return Reports of minisat+ runs, empty if tuning is disabled.
+       */
+      const std::vector<std::string>&
+      get_tunings() const;
+
+      /**
+       * @brief Creates frame of state variables.
+       *
+       * @param[in] solver SAT solver.
+       *
+       * @return Solver variables for state variables.
+       */
+      std::vector<int>
+      new_state(Sat_solver& solver);
+
+      /**
+       * @brief Creates frame of input variables.
+       *
+       * @param[in] solver SAT solver.
+       *
+       * @return Solver variables for input variables.
+       */
+      std::vector<int>
+      new_input(Sat_solver& solver);
+
+      /**
+       * @brief Adds initial conditions.
+       *
+       * @param[in] solver SAT solver.
+       * @param[in] state  State frame.
+       * @param[in] act    Activation literal, clauses are active only if it
+       *                   is true (0 for unconditional clauses).
+       */
+      void
+      add_init(Sat_solver& solver,
+               const std::vector<int>& state,
+               int act);
+
+      /**
+       * @brief Adds transitional relation.
+       *
+       * @param[in] solver SAT solver.
+       * @param[in] state  Current state frame.
+       * @param[in] input  Input frame.
+       * @param[in] next   Next state frame.
+       * @param[in] act    Activation literal, clauses are active only if it
+       *                   is true (0 for unconditional clauses).
+       */
+      void
+      add_trans(Sat_solver& solver,
+                const std::vector<int>& state,
+                const std::vector<int>& input,
+                const std::vector<int>& next,
+                int act);
+
+      /**
+       * @brief Adds specification.
+       *
+       * @param[in] solver SAT solver.
+       * @param[in] state  State frame.
+       * @param[in] act    Activation literal, clauses are active only if it
+       *                   is true (0 for unconditional clauses).
+       */
+      void
+      add_spec(Sat_solver& solver,
+               const std::vector<int>& state,
+               int act);
+
+      /**
+       * @brief Adds constraint that two states differ.
+       *
+       * @param[in] solver SAT solver.
+       * @param[in] state1 First state frame.
+       * @param[in] state2 Second state frame.
+       */
+      void
+      add_distinct(Sat_solver& solver,
+                   const std::vector<int>& state1,
+                   const std::vector<int>& state2);
+
+      /**
+       * @brief Checks if two states are equal in the solver model.
+       *
+       * @param[in] solver SAT solver after successful solve.
+       * @param[in] state1 First state frame.
+       * @param[in] state2 Second state frame.
+       *
+       * @return true if states are equal, false otherwise.
+       */
+      bool
+      equal_states(const Sat_solver& solver,
+                   const std::vector<int>& state1,
+                   const std::vector<int>& state2) const;
+
+      /**
+       * @brief Builds counterexample from the solver model.
+       *
+       * @param[in]  solver SAT solver after successful solve.
+       * @param[in]  states State frames from initial state to bad one.
+       * @param[in]  inputs Input frames (one less than state frames).
+       * @param[out] ce     Counterexample, it is (re)allocated.
+       */
+      void
+      get_counterexample(const Sat_solver& solver,
+                         const std::vector<std::vector<int> >& states,
+                         const std::vector<std::vector<int> >& inputs,
+                         Counterexample*& ce);
+
+      /**
+       * @brief Adds negation of specification.
+       *
+       * Negation of every specification constraint gets its own selector
+       * variable, at least one of them must be true.
+       *
+       * @param[in] solver SAT solver.
+       * @param[in] state  State frame.
+       * @param[in] act    Activation literal, clauses are active only if it
+       *                   is true (0 for unconditional clauses).
+       */
+      void
+      add_bad(Sat_solver& solver,
+              const std::vector<int>& state,
+              int act);
+
+    private:
+      /**
+       * @brief Instantiates CNF template.
+       *
+       * @param[in] solver SAT solver.
+       * @param[in] cnf    CNF template.
+       * @param[in] state  Current state frame.
+       * @param[in] input  Input frame.
+       * @param[in] next   Next state frame.
+       * @param[in] act    Activation literal (0 for unconditional clauses).
+       */
+      void
+      instantiate(Sat_solver& solver,
+                  const Cnf& cnf,
+                  const std::vector<int>& state,
+                  const std::vector<int>& input,
+                  const std::vector<int>& next,
+                  int act);
+
+    private:
+      /**
+       * @brief Frame kinds enum.
+       */
+      enum Frame
+      {
+        FRAME_STATE, ///< Current state frame.
+        FRAME_INPUT, ///< Input frame.
+        FRAME_NEXT   ///< Next state frame.
+      }; // enum Frame
+
+      /**
+       * @brief Pseudoboolean problem.
+       */
+      Problem& problem;
+
+      /**
+       * @brief Frame and index in the frame for every variable name.
+       */
+      std::map<std::string, std::pair<Frame, size_t> > refs;
+
+      Cnf init;             ///< Initial conditions.
+      Cnf trans;            ///< Transitional relation.
+      Cnf spec;             ///< Specification.
+      std::vector<Cnf> bad; ///< Negations of specification constraints.
+
+      /**
+       * @brief Thresholds tuned by minisat+.
+       */
+      std::vector<std::string> tunings;
+  }; // class Model_cnf
+}; // namespace mc_hybrid
+
+#endif // #ifndef MODEL_CNF_HPP_
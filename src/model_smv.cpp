@@ -8,6 +8,8 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <map>
+#include <algorithm>
 
 #include "types.hpp"
 #include "model_smv.hpp"
@@ -17,6 +19,7 @@
 #include "problem.hpp"
 #include "minisat_helpers.hpp"
 #include "paths.hpp"
+#include "nusmv_session.hpp"
 
 using std::string;
 using std::fstream;
@@ -25,10 +28,17 @@ using std::runtime_error;
 using std::endl;
 using std::ostringstream;
 using std::ostream;
+using std::vector;
+using std::map;
+using std::pair;
+using std::make_pair;
+using std::sort;
+using std::istringstream;
 
 namespace mc_hybrid
 {
-  Model_smv::Model_smv(Problem& problem)
+  Model_smv::Model_smv(Problem& problem, const Options& options) :
+    options(options)
   {
     // Fill variables names from problem.
     for (size_t i = 0; i < problem.get_variables_num(Problem::VARS_INPUT); ++i)
@@ -41,21 +51,41 @@ namespace mc_hybrid
       Variable& v = problem.get_variable(Problem::VARS_STATE, i);
       vars_state.push_back(v.get_name());
     }
-    // Generate cnfs.
+    // Generate cnfs by one minisat+ run: initial conditions, partitions of
+    // transitional relation and specification share aux variables of
+    // common subformulas.
+    vector<bool> consumed;
+    find_updates(problem, consumed);
+    vector<vector<size_t> > partitions;
+    partition_trans(problem, consumed, partitions);
+    vector<Constrs_subset> subsets(partitions.size() + 2);
+    subsets[0].group = Problem::CONSTRS_INIT;
+    for (size_t i = 0; i < problem.get_constraints_num(Problem::CONSTRS_INIT); ++i)
+      subsets[0].constrs.push_back(i);
+    for (size_t i = 0; i < partitions.size(); ++i)
+    {
+      subsets[i + 1].group = Problem::CONSTRS_TRANS;
+      subsets[i + 1].constrs = partitions[i];
+    }
+    subsets.back().group = Problem::CONSTRS_SPEC;
+    for (size_t i = 0; i < problem.get_constraints_num(Problem::CONSTRS_SPEC); ++i)
+      subsets.back().constrs.push_back(i);
+    vector<Cnf> cnfs;
+    minisat_launch(problem, options, subsets, cnfs, tunings);
+
     size_t aux_num = 0;
-    aux_num = minisat_launch(problem,
-                             Problem::CONSTRS_INIT,
-                             aux_num,
-                             init);
-    aux_num = minisat_launch(problem,
-                             Problem::CONSTRS_TRANS,
-                             aux_num,
-                             trans);
-    aux_num = minisat_launch(problem,
-                             Problem::CONSTRS_SPEC,
-                             aux_num,
-                             spec);
-    if (spec.length() == 0)
+    for (size_t i = 0; i < cnfs.size(); ++i)
+      if (cnfs[i].get_aux_num() > aux_num)
+        aux_num = cnfs[i].get_aux_num();
+    init.swap(cnfs[0]);
+    for (size_t i = 1; i + 1 < cnfs.size(); ++i)
+      if (cnfs[i].get_clauses_num() > 0)
+      {
+        trans.push_back(Cnf());
+        trans.back().swap(cnfs[i]);
+      }
+    spec.swap(cnfs.back());
+    if (spec.get_clauses_num() == 0)
       throw std::logic_error("Specification is empty while creating SMV model.");
 
     for (size_t i = 0; i < aux_num; ++i)
@@ -66,6 +96,199 @@ namespace mc_hybrid
     }
   }
 
+  void
+  Model_smv::find_updates(Problem& problem, vector<bool>& consumed)
+  {
+    size_t constrs_num = problem.get_constraints_num(Problem::CONSTRS_TRANS);
+    size_t vars_num = problem.get_constraints_vars_num(Problem::CONSTRS_TRANS);
+    consumed.assign(constrs_num, false);
+
+    // Coefficients (and free member as the last element) of each constraint.
+    vector<vector<real_t> > rows(constrs_num);
+    map<vector<real_t>, vector<size_t> > inequalities;
+    for (size_t i = 0; i < constrs_num; ++i)
+    {
+      Constraint& c = problem.get_constraint(Problem::CONSTRS_TRANS, i);
+      for (size_t j = 0; j < vars_num; ++j)
+        rows[i].push_back(c.get_coeff(problem.get_constraints_var(Problem::CONSTRS_TRANS, j)));
+      rows[i].push_back(c.get_free_member());
+      if (c.get_type() == Constraint::MORE_OR_EQUAL)
+        inequalities[rows[i]].push_back(i);
+    }
+
+    vector<bool> defined(problem.get_variables_num(Problem::VARS_NEXT_STATE), false);
+    map<string, size_t> next_idxs;
+    for (size_t i = 0; i < defined.size(); ++i)
+      next_idxs[problem.get_variable(Problem::VARS_NEXT_STATE, i).get_name()] = i;
+
+    for (size_t i = 0; i < constrs_num; ++i)
+    {
+      if (consumed[i])
+        continue;
+
+      Constraint& c = problem.get_constraint(Problem::CONSTRS_TRANS, i);
+      // Find the opposite inequality, if any.
+      size_t partner = constrs_num;
+      if (c.get_type() == Constraint::MORE_OR_EQUAL)
+      {
+        vector<real_t> opposite(rows[i]);
+        for (size_t j = 0; j < opposite.size(); ++j)
+          opposite[j] = -opposite[j];
+        map<vector<real_t>, vector<size_t> >::iterator iter =
+          inequalities.find(opposite);
+        if (iter == inequalities.end())
+          continue;
+        for (size_t j = 0; j < iter->second.size(); ++j)
+          if (!consumed[iter->second[j]] && iter->second[j] != i)
+          {
+            partner = iter->second[j];
+            break;
+          }
+        if (partner == constrs_num)
+          continue;
+      }
+
+      // Split the equality into next state bits and the rest.
+      vector<pair<real_t, size_t> > bits;
+      ostringstream expr;
+      bool ok = true;
+      for (size_t j = 0; j < vars_num && ok; ++j)
+      {
+        const real_t& coeff = rows[i][j];
+        if (coeff == 0)
+          continue;
+        Variable& v = problem.get_constraints_var(Problem::CONSTRS_TRANS, j);
+        map<string, size_t>::iterator iter = next_idxs.find(v.get_name());
+        if (iter != next_idxs.end())
+        {
+          ok = !defined[iter->second];
+          bits.push_back(make_pair(abs(coeff), iter->second));
+        }
+        else
+          expr << "case " << v.get_name() << " : " << coeff << "; 1 : 0; esac + ";
+      }
+      if (!ok || bits.size() == 0)
+        continue;
+      expr << rows[i].back();
+
+      // Weights of the bits must be a, 2a, 4a, ...
+      sort(bits.begin(), bits.end());
+      real_t a = bits[0].first;
+      real_t weight = a;
+      for (size_t k = 0; k < bits.size() && ok; ++k, weight *= 2)
+        ok = (bits[k].first == weight);
+      if (!ok)
+        continue;
+      Variable& first = problem.get_variable(Problem::VARS_NEXT_STATE, bits[0].second);
+      real_t sign = (c.get_coeff(first) > 0) ? -1 : 1;
+      for (size_t k = 1; k < bits.size() && ok; ++k)
+      {
+        Variable& v = problem.get_variable(Problem::VARS_NEXT_STATE, bits[k].second);
+        ok = (c.get_coeff(v) * sign < 0);
+      }
+      if (!ok)
+        continue;
+
+      // Bits value equals (sign * expr) / a.
+      ostringstream name;
+      name << "_upd" << defines.size() / 2;
+      ostringstream define;
+      define << name.str() << " := " << sign << " * (" << expr.str() << ")";
+      defines.push_back(define.str());
+      ostringstream guard;
+      guard << name.str() << "_ok := ";
+      if (a != 1)
+        guard << name.str() << " mod " << a << " = 0 & ";
+      guard << name.str() << " >= 0 & " << name.str() << " <= " << a * (weight / a - 1);
+      defines.push_back(guard.str());
+      guards.push_back(name.str() + "_ok");
+
+      weight = a;
+      for (size_t k = 0; k < bits.size(); ++k, weight *= 2)
+      {
+        string var_name = problem.get_variable(Problem::VARS_NEXT_STATE, bits[k].second).get_name();
+        var_name.erase(var_name.length() - 1);
+        ostringstream assign;
+        assign << "next(" << var_name << ") := case " << name.str() << "_ok : (" <<
+                  name.str() << " / " << weight << ") mod 2; 1 : 0; esac";
+        assigns.push_back(assign.str());
+        defined[bits[k].second] = true;
+      }
+      consumed[i] = true;
+      if (partner != constrs_num)
+        consumed[partner] = true;
+    }
+  }
+
+  void
+  Model_smv::partition_trans(Problem& problem,
+                             const vector<bool>& consumed,
+                             vector<vector<size_t> >& partitions)
+  {
+    size_t constrs_num = problem.get_constraints_num(Problem::CONSTRS_TRANS);
+    size_t vars_num = problem.get_variables_num(Problem::VARS_NEXT_STATE);
+
+    // Union-find over constraints: constraints are joined by next state
+    // variables they share.
+    vector<size_t> parent(constrs_num);
+    for (size_t i = 0; i < constrs_num; ++i)
+      parent[i] = i;
+    vector<size_t> owner(vars_num, constrs_num);
+    vector<bool> has_next(constrs_num, false);
+    for (size_t i = 0; i < constrs_num; ++i)
+    {
+      if (consumed[i])
+        continue;
+      Constraint& c = problem.get_constraint(Problem::CONSTRS_TRANS, i);
+      for (size_t j = 0; j < vars_num; ++j)
+      {
+        Variable& v = problem.get_variable(Problem::VARS_NEXT_STATE, j);
+        if (c.get_coeff(v) == 0)
+          continue;
+        has_next[i] = true;
+        if (owner[j] == constrs_num)
+        {
+          owner[j] = i;
+          continue;
+        }
+        size_t a = i;
+        while (parent[a] != a)
+          a = parent[a];
+        size_t b = owner[j];
+        while (parent[b] != b)
+          b = parent[b];
+        if (a != b)
+          parent[a < b ? b : a] = a < b ? a : b;
+      }
+    }
+
+    // Collect partitions in order of their first constraint.
+    partitions.clear();
+    vector<size_t> partition_idx(constrs_num, constrs_num);
+    vector<size_t> rest;
+    for (size_t i = 0; i < constrs_num; ++i)
+    {
+      if (consumed[i])
+        continue;
+      if (!has_next[i])
+      {
+        rest.push_back(i);
+        continue;
+      }
+      size_t root = i;
+      while (parent[root] != root)
+        root = parent[root];
+      if (partition_idx[root] == constrs_num)
+      {
+        partition_idx[root] = partitions.size();
+        partitions.push_back(vector<size_t>());
+      }
+      partitions[partition_idx[root]].push_back(i);
+    }
+    if (rest.size() > 0)
+      partitions.push_back(rest);
+  }
+
   bool
   Model_smv::refine(Counterexample& /*counterexample*/)
   {
@@ -75,47 +298,132 @@ namespace mc_hybrid
   void
   Model_smv::write(const string& filename)
   {
-    fstream file(filename.c_str(), ios::out | ios::trunc);
+    vector<char> buffer(1 << 20);
+    fstream file;
+    file.rdbuf()->pubsetbuf(&buffer[0], buffer.size());
+    file.open(filename.c_str(), ios::out | ios::trunc);
     if (!file)
       throw runtime_error("Can't create NuSMV input file.");
 
     file << *this; 
+    file.close();
+  }
+
+  void
+  Model_smv::write_cmds(ostream& s, bool reuse_order)
+  {
+    s << "reset" << endl;
+    s << "read_model -i " << nusmv_input_path << endl;
+    if (options.coi)
+      s << "set cone_of_influence" << endl;
+    else
+      s << "unset cone_of_influence" << endl;
+    if (options.nusmv_algorithm == Options::NUSMV_BMC)
+    {
+      s << "go_bmc" << endl;
+      s << "check_invar_bmc -a een-sorensson -k " << options.depth << endl;
+    }
+    else
+    {
+      if (reuse_order)
+        s << "set input_order_file " << nusmv_order_path << endl;
+      else
+        s << "unset input_order_file" << endl;
+      s << "set partition_method Iwls95CP" << endl;
+      s << "set image_cluster_size 1000" << endl;
+      s << "go" << endl;
+      s << "check_invar -s " <<
+           (options.backward ? "backward" : "forward") << endl;
+      s << "write_order -o " << nusmv_order_path << endl;
+    }
+    s << "show_traces -p 4 -o " << nusmv_output_path << endl;
   }
 
-  
+  /**
+   * @brief Gets result of invariant checking from NuSMV output.
+   *
+   * @param[in] output NuSMV output.
+   *
+   * @return true if invariant holds (or no counterexample is found up to
+   * @return the bound by BMC), false if it doesn't.
+   *
+   * @throw runtime_error if NuSMV reported an error or no result.
+   */
+  static bool
+  read_result(const string& output)
+  {
+    istringstream s(output);
+    string line;
+    bool holds = false;
+    bool fails = false;
+    while (getline(s, line))
+    {
+      // Output of a command follows the prompt on the same line.
+      const string prompt = "NuSMV > ";
+      while (line.compare(0, prompt.length(), prompt) == 0)
+        line.erase(0, prompt.length());
+      // Results contain the specification, so only other lines are
+      // searched for errors.
+      if (line.find("-- invariant ") == 0)
+      {
+        if (line.find(" is false") != string::npos)
+          fails = true;
+        else if (line.find(" is true") != string::npos)
+          holds = true;
+      }
+      else if (line.find("-- no proof or counterexample found") == 0)
+        holds = true;
+      else if (line.find("rror") != string::npos ||
+               line.find("ERROR") != string::npos)
+        throw runtime_error("NuSMV error: " + line);
+    }
+    if (fails)
+      return false;
+    if (!holds)
+      throw runtime_error("NuSMV reported no result of invariant checking.");
+    return true;
+  }
 
   bool
-  Model_smv::verify(Counterexample* ce)
+  Model_smv::verify(Nusmv_session& session, Counterexample*& ce)
   {
     bool result = false;
 
     write(nusmv_input_path);
 
-    string nusmv_cmd = nusmv_exec_path;
-    nusmv_cmd += " -load ";
-    nusmv_cmd += nusmv_cmds_path;
-    nusmv_cmd += " ";
-    nusmv_cmd += nusmv_input_path;
-    nusmv_cmd += " > /dev/null 2>&1";
+    fstream order(nusmv_order_path);
+    bool reuse_order = order.is_open();
+    order.close();
+
+    ostringstream cmds;
+    write_cmds(cmds, reuse_order);
+    string output;
+    bool completed = session.execute(cmds.str(), output, options.timeout);
 
-    if (system(nusmv_cmd.c_str()) != 0)
-      throw runtime_error("NuSMV can't be launched.");
-    
     remove(nusmv_input_path);
+    if (!completed)
+    {
+      remove(nusmv_output_path);
+      throw runtime_error("NuSMV timeout has expired.");
+    }
 
-    fstream file(nusmv_output_path);
-    if (file)
+    try
+    {
+      result = read_result(output);
+    }
+    catch (...)
+    {
+      remove(nusmv_output_path);
+      throw;
+    }
+    if (!result)
     {
-      file.close();
       if (ce != 0)
         delete ce;
       ce = new Counterexample(*this);
       //ce->read(nusmv_output_path);
-      remove(nusmv_output_path);
-      result = false;
     }
-    else
-      result = true;
+    remove(nusmv_output_path);
 
     return result;
   }
@@ -132,20 +440,47 @@ namespace mc_hybrid
     for (size_t i = 0; i < m.vars_state.size(); ++i)
       s << "  " << m.vars_state.at(i) << " : 0 .. 1;" << endl;
 
-    if (m.init.length() > 0)
+    if (m.defines.size() > 0)
+    {
+      s << "DEFINE" << endl;
+      for (size_t i = 0; i < m.defines.size(); ++i)
+        s << "  " << m.defines.at(i) << ";" << endl;
+    }
+
+    if (m.assigns.size() > 0)
+    {
+      s << "ASSIGN" << endl;
+      for (size_t i = 0; i < m.assigns.size(); ++i)
+        s << "  " << m.assigns.at(i) << ";" << endl;
+    }
+
+    // Aux variables are numbered by minisat+ the same way in all CNFs.
+    if (m.init.get_clauses_num() > 0)
     {
       s << "INIT" << endl;
-      s << "  " << m.init << ";" << endl;
+      s << "  ";
+      m.init.write_smv(s, 0);
+      s << ";" << endl;
+    }
+
+    for (size_t i = 0; i < m.guards.size(); ++i)
+    {
+      s << "TRANS" << endl;
+      s << "  " << m.guards.at(i) << ";" << endl;
     }
 
-    if (m.trans.length() > 0)
+    for (size_t i = 0; i < m.trans.size(); ++i)
     {
       s << "TRANS" << endl;
-      s << "  " << m.trans  << ";" << endl;
+      s << "  ";
+      m.trans.at(i).write_smv(s, 0);
+      s << ";" << endl;
     }
 
-    s << "SPEC" << endl;
-    s << "  AG (" << m.spec << ");" << endl;
+    s << "INVARSPEC" << endl;
+    s << "  ";
+    m.spec.write_smv(s, 0);
+    s << ";" << endl;
 
     return s;
   }
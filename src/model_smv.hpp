@@ -12,10 +12,14 @@
 #include <string>
 #include <ostream>
 
+#include "options.hpp"
+#include "cnf.hpp"
+
 namespace mc_hybrid
 {
   class Problem;
   class Counterexample;
+  class Nusmv_session;
 
   /**
    * @brief SMV model representation.
@@ -29,8 +33,10 @@ namespace mc_hybrid
        * @attention Problem must be pseudoboolean.
        *
        * @param[in] problem Problem.
+       * @param[in] options Verification options, NuSMV algorithm is chosen
+       *                    by them.
        */
-      Model_smv(Problem& problem);
+      Model_smv(Problem& problem, const Options& options);
 
       /**
        * @brief Refines model
@@ -43,20 +49,40 @@ namespace mc_hybrid
       /**
        * @brief Writes model to file with specified name.
        *
+       * CNFs are streamed into the file through a large buffer.
+       *
        * @param[in] filename Filename.
        */
       void
       write(const std::string& filename);
 
+      /**
+       * @brief Writes NuSMV commands for verification.
+       *
+       * Commands reset NuSMV, read the model from nusmv_input_path, build
+       * it and check the invariant by the algorithm from options,
+       * counterexample is written in XML format to nusmv_output_path. BDD
+       * variables order is saved to nusmv_order_path for the next
+       * refinement iterations.
+       *
+       * @param[out] s           Output stream.
+       * @param[in]  reuse_order Read initial variables order from
+       *                         nusmv_order_path.
+       */
+      void
+      write_cmds(std::ostream& s, bool reuse_order);
+
       /**
        * @brief Verify model using NuSMV model checker.
        *
-       * @param[in] ce Counterexample.
+       * @param[in]  session NuSMV session.
+       * @param[out] ce      Counterexample, it is allocated if verification
+       *                     fails.
        *
        * @return true if model fits specification, false otherwise.
        */
       bool
-      verify(Counterexample* ce);
+      verify(Nusmv_session& session, Counterexample*& ce);
 
       friend std::ostream&
       operator<<(std::ostream& s, Model_smv& m);
@@ -65,11 +91,50 @@ namespace mc_hybrid
       std::vector<std::string> vars_input; ///< Input variables.
       std::vector<std::string> vars_state; ///< State variables.
 
-      std::string init;  ///< Initial conditions.
-      std::string trans; ///< Transitional relation.
-      std::string spec;  ///< Specification.
+      Cnf init;                         ///< Initial conditions.
+      std::vector<Cnf> trans;           ///< Partitions of transitional relation.
+      std::vector<std::string> guards;  ///< Guards of functional updates.
+      std::vector<std::string> assigns; ///< Functional next state updates.
+      Cnf spec;                         ///< Specification.
+      std::vector<std::string> tunings; ///< Thresholds tuned by minisat+.
+
+    private:
+      /**
+       * @brief Finds functional next state updates.
+       *
+       * Looks for transitional relation equalities (either EQUAL constraints
+       * or pairs of opposite inequalities) of the form
+       * a * (b_0' + 2 b_1' + ... + 2^m b_m') + E = 0, where E depends only on
+       * current state and input variables. Every such equality defines the
+       * next state bits b_k' as functions of the current state and input,
+       * so it is replaced by ASSIGN next(b_k) := ... and a guard in TRANS
+       * requiring -E / a to be a value representable by the bits.
+       *
+       * @param[in]  problem  Problem.
+       * @param[out] consumed Flags of constraints replaced by assignments.
+       */
+      void
+      find_updates(Problem& problem, std::vector<bool>& consumed);
+
+      /**
+       * @brief Splits transitional relation constraints into partitions.
+       *
+       * Constraints sharing a next state variable are put into the same
+       * partition, so each partition defines its own cluster of next state
+       * variables. Constraints without next state variables form one more
+       * partition.
+       *
+       * @param[in]  problem    Problem.
+       * @param[in]  consumed   Flags of constraints to skip.
+       * @param[out] partitions Indices of constraints for each partition.
+       */
+      void
+      partition_trans(Problem& problem,
+                      const std::vector<bool>& consumed,
+                      std::vector<std::vector<size_t> >& partitions);
 
     private:
+      Options options;                  ///< Verification options.
       size_t tmax;                      ///< Maximal length of counterexample.
       std::vector<std::string> defines; ///< Defines.
   }; // class Model_smv
@@ -0,0 +1,219 @@
+/**
+ * @file nusmv_session.cpp
+ * @brief Nusmv_session class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <cstdio>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <stdexcept>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+#include "nusmv_session.hpp"
+#include "paths.hpp"
+
+using std::string;
+using std::runtime_error;
+
+namespace mc_hybrid
+{
+  /**
+   * @brief Marker echoed by NuSMV after commands are completed.
+   */
+  static const char* nusmv_marker = "__mc_hybrid_done__";
+
+  /**
+   * @brief Gets monotonic time.
+   *
+   * @return Time in milliseconds.
+   */
+  static long long
+  now_ms()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+  }
+
+  Nusmv_session::Nusmv_session() :
+    pid(0),
+    to_nusmv(-1),
+    from_nusmv(-1)
+  {
+  }
+
+  Nusmv_session::~Nusmv_session()
+  {
+    if (is_running())
+    {
+      // Errors don't matter here, process is waited for anyway.
+      const char quit[] = "quit\n";
+      ssize_t written = write(to_nusmv, quit, sizeof(quit) - 1);
+      (void)written;
+      stop();
+    }
+    remove(nusmv_order_path);
+  }
+
+  bool
+  Nusmv_session::execute(const string& cmds, string& output, int timeout)
+  {
+    if (!is_running())
+      start();
+
+    string input = cmds;
+    input += "echo ";
+    input += nusmv_marker;
+    input += "\n";
+
+    size_t pos = 0;
+    while (pos < input.length())
+    {
+      ssize_t n = write(to_nusmv, input.data() + pos, input.length() - pos);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n < 0)
+      {
+        cancel();
+        throw runtime_error("NuSMV can't be launched.");
+      }
+      pos += n;
+    }
+
+    output.clear();
+    long long deadline = now_ms() + (long long)timeout * 1000;
+    char buf[4096];
+    for (;;)
+    {
+      size_t found = output.find(nusmv_marker);
+      if (found != string::npos)
+      {
+        output.erase(found);
+        return true;
+      }
+
+      int wait = -1;
+      if (timeout > 0)
+      {
+        long long left = deadline - now_ms();
+        if (left <= 0)
+        {
+          cancel();
+          return false;
+        }
+        wait = int(left);
+      }
+
+      pollfd pfd;
+      pfd.fd = from_nusmv;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      int ready = poll(&pfd, 1, wait);
+      if (ready < 0 && errno == EINTR)
+        continue;
+      if (ready < 0)
+      {
+        cancel();
+        throw runtime_error("Can't read NuSMV output.");
+      }
+      if (ready == 0)
+        continue;
+
+      ssize_t n = read(from_nusmv, buf, sizeof(buf));
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+      {
+        cancel();
+        throw runtime_error("NuSMV can't be launched.");
+      }
+      output.append(buf, n);
+    }
+  }
+
+  void
+  Nusmv_session::cancel()
+  {
+    if (pid > 0)
+      kill(pid, SIGKILL);
+    stop();
+  }
+
+  bool
+  Nusmv_session::is_running() const
+  {
+    return pid > 0;
+  }
+
+  void
+  Nusmv_session::start()
+  {
+    int in[2];
+    int out[2];
+    if (pipe(in) != 0)
+      throw runtime_error("Can't create pipe for NuSMV.");
+    if (pipe(out) != 0)
+    {
+      close(in[0]);
+      close(in[1]);
+      throw runtime_error("Can't create pipe for NuSMV.");
+    }
+
+    // Broken pipe is reported by write.
+    signal(SIGPIPE, SIG_IGN);
+
+    pid = fork();
+    if (pid < 0)
+    {
+      pid = 0;
+      close(in[0]);
+      close(in[1]);
+      close(out[0]);
+      close(out[1]);
+      throw runtime_error("NuSMV can't be launched.");
+    }
+
+    if (pid == 0)
+    {
+      dup2(in[0], STDIN_FILENO);
+      dup2(out[1], STDOUT_FILENO);
+      dup2(out[1], STDERR_FILENO);
+      close(in[0]);
+      close(in[1]);
+      close(out[0]);
+      close(out[1]);
+      execlp(nusmv_exec_path, nusmv_exec_path, "-int", (char*)0);
+      _exit(127);
+    }
+
+    close(in[0]);
+    close(out[1]);
+    to_nusmv = in[1];
+    from_nusmv = out[0];
+  }
+
+  void
+  Nusmv_session::stop()
+  {
+    if (to_nusmv >= 0)
+      close(to_nusmv);
+    to_nusmv = -1;
+
+    if (from_nusmv >= 0)
+      close(from_nusmv);
+    from_nusmv = -1;
+
+    if (pid > 0)
+    {
+      int status;
+      while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        ;
+    }
+    pid = 0;
+  }
+}; // namespace mc_hybrid
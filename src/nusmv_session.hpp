@@ -0,0 +1,102 @@
+/**
+ * @file nusmv_session.hpp
+ * @brief Nusmv_session class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef NUSMV_SESSION_HPP_
+#define NUSMV_SESSION_HPP_
+
+#include <string>
+
+#include <sys/types.h>
+
+namespace mc_hybrid
+{
+  /**
+   * @brief Persistent NuSMV process in interactive mode.
+   *
+   * NuSMV is launched once with -int option and driven through pipes
+   * connected to its standard input and output, so startup costs are paid
+   * only once for all queries of the session. Process is launched lazily by
+   * the first command and relaunched after cancellation.
+   */
+  class Nusmv_session
+  {
+    public:
+      /**
+       * @brief Default constructor.
+       */
+      Nusmv_session();
+
+      /**
+       * @brief Destructor.
+       *
+       * Quits NuSMV and removes variables order file.
+       */
+      ~Nusmv_session();
+
+      /**
+       * @brief Executes commands.
+       *
+       * Commands are sent to NuSMV followed by echo of a marker, so
+       * completion is detected by the marker in the output.
+       *
+       * @param[in]  cmds    Commands, one per line.
+       * @param[out] output  NuSMV output (prompts included).
+       * @param[in]  timeout Timeout in seconds, 0 means no timeout.
+       *
+       * @return true if commands are completed, false if timeout has expired
+       * @return (NuSMV is cancelled then).
+       */
+      bool
+      execute(const std::string& cmds, std::string& output, int timeout);
+
+      /**
+       * @brief Cancels current query.
+       *
+       * Kills NuSMV process, the next command launches it again.
+       */
+      void
+      cancel();
+
+      /**
+       * @brief Checks if NuSMV process is running.
+       *
+       * @return true if process is running, false otherwise.
+       */
+      bool
+      is_running() const;
+
+    private:
+      /**
+       * @brief Launches NuSMV process.
+       */
+      void
+      start();
+
+      /**
+       * @brief Closes pipes and waits for NuSMV process.
+       */
+      void
+      stop();
+
+      /**
+       * @brief Copy constructor is disabled.
+       */
+      Nusmv_session(const Nusmv_session&);
+
+      /**
+       * @brief Assignment is disabled.
+       */
+      Nusmv_session&
+      operator=(const Nusmv_session&);
+
+    private:
+      pid_t pid;        ///< NuSMV process id, 0 if it isn't running.
+      int to_nusmv;     ///< Pipe to NuSMV standard input.
+      int from_nusmv;   ///< Pipe from NuSMV standard output and error.
+  }; // class Nusmv_session
+}; // namespace mc_hybrid
+
+#endif // #ifndef NUSMV_SESSION_HPP_
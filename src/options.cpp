@@ -0,0 +1,50 @@
+/**
+ * @file options.cpp
+ * @brief Options struct methods definition.
+ * @date 18.10.2026
+ */
+
+#include "options.hpp"
+
+namespace mc_hybrid
+{
+  const char* engines_names[Options::ENGINES_TOTAL] =
+  {
+    "nusmv",
+    "bdd",
+    "bmc",
+    "kind",
+    "ic3"
+  };
+
+  const char* nusmv_algorithms_names[Options::NUSMV_ALGORITHMS_TOTAL] =
+  {
+    "bdd",
+    "bmc"
+  };
+
+  const char* encodings_names[Options::ENCODINGS_TOTAL] =
+  {
+    "binary",
+    "order",
+    "onehot",
+    "auto"
+  };
+
+  Options::Options()
+  {
+    verbosity = 1;
+    q_param = 4;
+    engine = ENGINE_NUSMV;
+    backward = false;
+    depth = 20;
+    nusmv_algorithm = NUSMV_BDD;
+    coi = false;
+    timeout = 0;
+    encoding = ENCODING_BINARY;
+    approximate = false;
+    preprocess = true;
+    threads = 1;
+    tune = 0;
+  }
+}; // namespace mc_hybrid
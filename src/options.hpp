@@ -0,0 +1,94 @@
+/**
+ * @file options.hpp
+ * @brief Options struct definition.
+ * @date 18.10.2026
+ */
+
+#ifndef OPTIONS_HPP_
+#define OPTIONS_HPP_
+
+#include <map>
+#include <string>
+
+namespace mc_hybrid
+{
+  /**
+   * @brief Verification options.
+   */
+  struct Options
+  {
+    /**
+     * @brief Model checking engines enum.
+     */
+    enum Engine
+    {
+      ENGINE_NUSMV, ///< NuSMV launched on the generated SMV model.
+      ENGINE_BDD,   ///< In-process symbolic reachability using CUDD.
+      ENGINE_BMC,   ///< In-process bounded model checking using MiniSat.
+      ENGINE_KIND,  ///< k-induction using MiniSat, NuSMV if inconclusive.
+      ENGINE_IC3,   ///< IC3/PDR using MiniSat.
+      ENGINES_TOTAL
+    }; // enum Engine
+
+    /**
+     * @brief NuSMV invariant checking algorithms enum.
+     */
+    enum Nusmv_algorithm
+    {
+      NUSMV_BDD, ///< check_invar, forward or backward BDD reachability.
+      NUSMV_BMC, ///< check_invar_bmc with maximal depth.
+      NUSMV_ALGORITHMS_TOTAL
+    }; // enum Nusmv_algorithm
+
+    /**
+     * @brief Encodings of discrete variables by boolean ones enum.
+     */
+    enum Encoding
+    {
+      ENCODING_BINARY, ///< Bit k has weight 2^k.
+      ENCODING_ORDER,  ///< Bit k is set iff value > lower bound + k.
+      ENCODING_ONEHOT, ///< Bit k is set iff value == lower bound + k.
+      ENCODING_AUTO,   ///< Order for small domains, binary otherwise.
+      ENCODINGS_TOTAL
+    }; // enum Encoding
+
+    /**
+     * @brief Default constructor.
+     *
+     * This constructor assigns default values to all options.
+     */
+    Options();
+
+    int verbosity;    ///< Verbosity value.
+    int q_param;      ///< Initial value of quantization param.
+    Engine engine;    ///< Model checking engine.
+    bool backward;    ///< Use backward reachability in the BDD engines.
+    int depth;        ///< Maximal depth for the BMC and k-induction engines.
+    Nusmv_algorithm nusmv_algorithm; ///< NuSMV invariant checking algorithm.
+    bool coi;         ///< Let NuSMV use cone of influence reduction.
+    int timeout;      ///< Timeout of NuSMV query in seconds, 0 for none.
+    Encoding encoding; ///< Encoding of discrete variables.
+    bool approximate; ///< Eliminate real variables by their bounds, not FM.
+    bool preprocess;  ///< Eliminate aux variables of CNFs by SatELite.
+    int threads;      ///< Threads of minisat+ conversion, 0 for processors.
+    int tune;         ///< Constraints minisat+ tunes thresholds on, 0 for none.
+    std::map<std::string, Encoding> vars_encodings; ///< Per variable encodings.
+  }; // struct Options
+
+  /**
+   * @brief Engines names (values of command line option).
+   */
+  extern const char* engines_names[Options::ENGINES_TOTAL];
+
+  /**
+   * @brief NuSMV algorithms names (values of command line option).
+   */
+  extern const char* nusmv_algorithms_names[Options::NUSMV_ALGORITHMS_TOTAL];
+
+  /**
+   * @brief Encodings names (values of command line option).
+   */
+  extern const char* encodings_names[Options::ENCODINGS_TOTAL];
+}; // namespace mc_hybrid
+
+#endif // #ifndef OPTIONS_HPP_
@@ -8,11 +8,10 @@
 namespace mc_hybrid
 {
   const char* minisat_input_path = "./minisat_input";
-  const char* minisat_output_path = "./minisat_output";
   const char* minisat_exec_path = "./minisat+.exe";
 
   const char* nusmv_input_path = "./nusmv_input";
   const char* nusmv_output_path = "./counterexample.xml";
   const char* nusmv_exec_path = "NuSMV";
-  const char* nusmv_cmds_path = "./nusmv_cmds";
+  const char* nusmv_order_path = "./nusmv_order";
 }; // namespace mc_hybrid
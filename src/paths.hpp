@@ -11,13 +11,12 @@
 namespace mc_hybrid
 {
   extern const char* minisat_input_path;  ///< Path to Minisat+ input file.
-  extern const char* minisat_output_path; ///< Path to Minisat+ output file.
   extern const char* minisat_exec_path;   ///< Path to Minisat+ executable.
 
   extern const char* nusmv_input_path;  ///< Path to NuSMV input file.
   extern const char* nusmv_output_path; ///< Path to NuSMV output file.
   extern const char* nusmv_exec_path;   ///< Path to NuSMV executable.
-  extern const char* nusmv_cmds_path;   ///< Path to the file with commands for NuSMV interactive mode.
+  extern const char* nusmv_order_path;  ///< Path to NuSMV variables order file.
 }; // namespace mc_hybrid
 
 #endif // #ifndef PATHS_HPP_
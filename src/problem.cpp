@@ -6,6 +6,8 @@
  */
 
 #include <ostream>
+#include <sstream>
+#include <algorithm>
 
 #include "types.hpp"
 #include "variable.hpp"
@@ -16,6 +18,10 @@
 using std::string;
 using std::ostream;
 using std::endl;
+using std::map;
+using std::vector;
+using std::unordered_map;
+using std::ostringstream;
 
 namespace mc_hybrid
 {
@@ -119,13 +125,165 @@ namespace mc_hybrid
   void
   Problem::add_constraint(Constrs_group group, const Constraint& c)
   {
-    if (group < CONSTRS_GROUPS_TOTAL)
+    if (group >= CONSTRS_GROUPS_TOTAL)
+      throw Constrs_group_out_of_range();
+
+    const size_t npos = Sum_bounds::npos;
+    Constraint canonical(c);
+    canonical.canonicalize();
+    bool equal = (canonical.get_type() == Constraint::EQUAL);
+    if (canonical.get_coeffs().empty())
+    {
+      real_t free_member = canonical.get_free_member();
+      if (equal ? free_member == 0 : free_member >= 0)
+        return;
+      append_constraint(group, canonical);
+      return;
+    }
+
+    string key;
+    bool upper;
+    real_t bound;
+    get_constraint_sum(canonical, key, upper, bound);
+    bool lower = equal || !upper;
+    upper = equal || upper;
+    Sum_bounds& sum = constrs_sums[group][key];
+
+    // Implied by the kept bounds.
+    if ((!lower || (sum.lower != npos && sum.lower_val >= bound)) &&
+        (!upper || (sum.upper != npos && sum.upper_val <= bound)))
+      return;
+    // Contradicts them, nothing to replace.
+    if ((lower && sum.upper != npos && bound > sum.upper_val) ||
+        (upper && sum.lower != npos && bound < sum.lower_val))
+    {
+      append_constraint(group, canonical);
+      return;
+    }
+
+    // Constraint replaces the bounds it tightens, or both of them if they
+    // become equal.
+    bool fold = equal ||
+                (lower && sum.upper != npos && sum.upper_val == bound) ||
+                (upper && sum.lower != npos && sum.lower_val == bound);
+    if (fold && !equal)
+    {
+      canonical.set_type(Constraint::EQUAL);
+      canonical.canonicalize();
+    }
+    size_t replaced_lower = (lower || fold) ? sum.lower : npos;
+    size_t replaced_upper = (upper || fold) ? sum.upper : npos;
+    size_t idx = std::min(replaced_lower, replaced_upper);
+    if (idx == npos)
     {
-      constrs.push_back(c);
-      constrs_groups_idxs[group].push_back(constrs.size() - 1);
+      idx = append_constraint(group, canonical);
     }
     else
-      throw Constrs_group_out_of_range();
+    {
+      constrs[idx] = canonical;
+      size_t other = std::max(replaced_lower, replaced_upper);
+      if (other != npos && other != idx)
+        remove_constraint(other);
+    }
+
+    if (lower || fold)
+    {
+      sum.lower = idx;
+      sum.lower_val = bound;
+    }
+    if (upper || fold)
+    {
+      sum.upper = idx;
+      sum.upper_val = bound;
+    }
+  }
+
+  void
+  Problem::canonicalize_constraints()
+  {
+    vector<Constraint> old_constrs;
+    vector<size_t> old_groups_idxs[CONSTRS_GROUPS_TOTAL];
+    old_constrs.swap(constrs);
+    constrs_places.clear();
+    for (size_t i = 0; i < CONSTRS_GROUPS_TOTAL; ++i)
+    {
+      old_groups_idxs[i].swap(constrs_groups_idxs[i]);
+      constrs_sums[i].clear();
+    }
+    for (size_t i = 0; i < CONSTRS_GROUPS_TOTAL; ++i)
+      for (size_t j = 0; j < old_groups_idxs[i].size(); ++j)
+        add_constraint(Constrs_group(i), old_constrs[old_groups_idxs[i][j]]);
+  }
+
+  void
+  Problem::get_constraint_sum(const Constraint& c,
+                              string& key,
+                              bool& upper,
+                              real_t& bound) const
+  {
+    const map<string, real_t>& coeffs = c.get_coeffs();
+    map<string, real_t>::const_iterator iter;
+    int_t divisor = 0;
+    for (iter = coeffs.begin(); iter != coeffs.end(); ++iter)
+      divisor = gcd(divisor, iter->second.get_num());
+    if (coeffs.begin()->second < 0)
+      divisor = -divisor;
+
+    ostringstream s;
+    for (iter = coeffs.begin(); iter != coeffs.end(); ++iter)
+      s << iter->first << " " << real_t(iter->second / divisor) << " ";
+    key = s.str();
+    // divisor * sum + free_member >= 0
+    upper = (divisor < 0);
+    bound = -c.get_free_member() / divisor;
+  }
+
+  void
+  Problem::remove_constraint(size_t idx)
+  {
+    // Last constraint of the group takes position of the removed one.
+    vector<size_t>& idxs = constrs_groups_idxs[constrs_places.at(idx).first];
+    size_t pos = constrs_places[idx].second;
+    idxs[pos] = idxs.back();
+    constrs_places[idxs[pos]].second = pos;
+    idxs.pop_back();
+
+    // Last constraint takes index of the removed one.
+    size_t last = constrs.size() - 1;
+    if (idx != last)
+    {
+      constrs[idx] = constrs[last];
+      constrs_places[idx] = constrs_places[last];
+      Constrs_group group = constrs_places[idx].first;
+      constrs_groups_idxs[group][constrs_places[idx].second] = idx;
+      if (!constrs[idx].get_coeffs().empty())
+      {
+        string key;
+        bool upper;
+        real_t bound;
+        get_constraint_sum(constrs[idx], key, upper, bound);
+        unordered_map<string, Sum_bounds>::iterator iter =
+          constrs_sums[group].find(key);
+        if (iter != constrs_sums[group].end())
+        {
+          if (iter->second.lower == last)
+            iter->second.lower = idx;
+          if (iter->second.upper == last)
+            iter->second.upper = idx;
+        }
+      }
+    }
+    constrs.pop_back();
+    constrs_places.pop_back();
+  }
+
+  size_t
+  Problem::append_constraint(Constrs_group group, const Constraint& c)
+  {
+    constrs.push_back(c);
+    constrs_places.push_back(std::make_pair(group, constrs_groups_idxs[group].size()));
+    constrs_groups_idxs[group].push_back(constrs.size() - 1);
+    return constrs.size() - 1;
   }
 
   size_t
@@ -162,10 +320,12 @@ namespace mc_hybrid
     for (size_t i = 0; i < VARS_GROUPS_TOTAL; ++i)
       vars_groups_idxs[i].clear();
     constrs.clear();
+    constrs_places.clear();
     for (size_t i = 0; i < CONSTRS_GROUPS_TOTAL; ++i)
     {
       constrs_groups_idxs[i].clear();
       constrs_groups_vars_idxs[i].clear();
+      constrs_sums[i].clear();
     }
   }
 
@@ -9,6 +9,9 @@
 #define PROBLEM_HPP_
 
 #include <vector>
+#include <utility>
+#include <string>
+#include <unordered_map>
 #include <stdexcept>
 #include <iosfwd>
 
@@ -177,12 +180,31 @@ namespace mc_hybrid
       /**
        * @brief Adds constraint to specified group.
        *
+       * Constraint is added in canonical form (see
+       * Constraint::canonicalize()). Constraints of a group with the same
+       * coefficients up to a factor bound the same sum from below and
+       * above, so only the tightest bounds are kept: constraint which is
+       * implied by the group ones (duplicate) isn't added, the one it
+       * implies is replaced by it, and bounds becoming equal are folded into
+       * equality. Trivially true constraints without variables aren't added.
+       * Contradicting bounds are added as they are.
+       *
        * @param[in] group Constraints group.
        * @param[in] c     Constraint.
        */
       void
       add_constraint(Constrs_group group, const Constraint& c);
 
+      /**
+       * @brief Adds all constraints again.
+       *
+       * Must be called after constraints are changed in place (through
+       * get_constraint()), so they are in canonical form and duplicates are
+       * found again.
+       */
+      void
+      canonicalize_constraints();
+
       /**
        * @brief Get variables number for specified constraints group.
        *
@@ -228,7 +250,68 @@ namespace mc_hybrid
       void
       clear();
 
+      /**
+       * @brief Gets the sum bounded by canonical constraint.
+       *
+       * Sum is the one of coefficients divided by their gcd and made with
+       * positive first coefficient.
+       *
+       * @param[in]  c     Canonical constraint with variables.
+       * @param[out] key   Sum written as string.
+       * @param[out] upper true if constraint bounds sum from above.
+       * @param[out] bound Bound (value of sum for equality).
+       */
+      void
+      get_constraint_sum(const Constraint& c,
+                         std::string& key,
+                         bool& upper,
+                         real_t& bound) const;
+
+      /**
+       * @brief Removes constraint.
+       *
+       * Last constraint takes index of the removed one, and last constraint
+       * of the same group takes its position in the group.
+       *
+       * @param[in] idx Constraint index.
+       */
+      void
+      remove_constraint(size_t idx);
+
     private:
+      /**
+       * @brief Appends constraint to specified group.
+       *
+       * @param[in] group Constraints group.
+       * @param[in] c     Constraint.
+       *
+       * @return Constraint index.
+       */
+      size_t
+      append_constraint(Constrs_group group, const Constraint& c);
+
+      /**
+       * @brief Constraints bounding the same sum.
+       */
+      struct Sum_bounds
+      {
+        static const size_t npos = size_t(-1); ///< No constraint index.
+
+        size_t lower;      ///< Index of lower bound constraint or npos.
+        size_t upper;      ///< Index of upper bound constraint or npos.
+        real_t lower_val;  ///< Lower bound.
+        real_t upper_val;  ///< Upper bound.
+
+        /**
+         * @brief Constructor.
+         */
+        Sum_bounds() :
+          lower(npos),
+          upper(npos)
+        {
+        }
+      }; // struct Sum_bounds
+
       /**
        * @brief Variables array.
        */
@@ -245,10 +328,20 @@ namespace mc_hybrid
        * @brief Array of constraints idxs for each constraints group.
        */
       std::vector<size_t> constrs_groups_idxs[CONSTRS_GROUPS_TOTAL];
+      /**
+       * @brief Group and position in it for each constraint.
+       */
+      std::vector<std::pair<Constrs_group, size_t> > constrs_places;
       /**
        * @brief Array of variables idxs for each constraints group.
        */
       std::vector<size_t> constrs_groups_vars_idxs[CONSTRS_GROUPS_TOTAL];
+      /**
+       * @brief Bounds of sums for each constraints group (equality is both
+       * @brief lower and upper bound).
+       */
+      std::unordered_map<std::string, Sum_bounds>
+        constrs_sums[CONSTRS_GROUPS_TOTAL];
   }; // class Problem
 
   /**
@@ -0,0 +1,102 @@
+/**
+ * @file sat_solver.cpp
+ * @brief Sat_solver class methods definition.
+ * @date 18.10.2026
+ */
+
+#include <cstdio>
+#include <cstdarg>
+#include <cstdlib>
+
+#include "Global.h"
+#include "MiniSat.h"
+
+#include "sat_solver.hpp"
+
+using std::vector;
+
+/**
+ * @brief Prints MiniSat progress messages.
+ *
+ * Is required by minisat+ solver library.
+ *
+ * @param[in] format Format string.
+ */
+void
+reportf(const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+namespace mc_hybrid
+{
+  /**
+   * @brief Converts DIMACS literal into MiniSat literal.
+   *
+   * @param[in] lit DIMACS literal.
+   *
+   * @return MiniSat literal.
+   */
+  static Lit
+  to_minisat_lit(int lit)
+  {
+    return (lit > 0) ? Lit(lit - 1) : ~Lit(-lit - 1);
+  }
+
+  Sat_solver::Sat_solver()
+  {
+    solver = new MiniSat::Solver();
+  }
+
+  Sat_solver::~Sat_solver()
+  {
+    delete solver;
+  }
+
+  int
+  Sat_solver::new_var()
+  {
+    return solver->newVar() + 1;
+  }
+
+  size_t
+  Sat_solver::get_vars_num() const
+  {
+    return solver->nVars();
+  }
+
+  bool
+  Sat_solver::add_clause(const vector<int>& clause)
+  {
+    vec<Lit> lits;
+    for (size_t i = 0; i < clause.size(); ++i)
+      lits.push(to_minisat_lit(clause[i]));
+    return solver->addClause(lits);
+  }
+
+  bool
+  Sat_solver::solve(const vector<int>& assumps)
+  {
+    vec<Lit> lits;
+    for (size_t i = 0; i < assumps.size(); ++i)
+      lits.push(to_minisat_lit(assumps[i]));
+    return solver->solve(lits);
+  }
+
+  bool
+  Sat_solver::solve()
+  {
+    vector<int> assumps;
+    return solve(assumps);
+  }
+
+  bool
+  Sat_solver::get_value(int lit) const
+  {
+    lbool value = solver->model[abs(lit) - 1];
+    return (lit > 0) ? (value == l_True) : (value == l_False);
+  }
+}; // namespace mc_hybrid
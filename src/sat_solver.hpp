@@ -0,0 +1,119 @@
+/**
+ * @file sat_solver.hpp
+ * @brief Sat_solver class definition.
+ * @date 18.10.2026
+ */
+
+#ifndef SAT_SOLVER_HPP_
+#define SAT_SOLVER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace MiniSat
+{
+  class Solver;
+}; // namespace MiniSat
+
+namespace mc_hybrid
+{
+  /**
+   * @brief Incremental SAT solver.
+   *
+   * Thin wrapper around MiniSat solver from minisat+ sources. Variables are
+   * numbered from 1, literals are nonzero integers (negative for negated
+   * variables) as in DIMACS format.
+   */
+  class Sat_solver
+  {
+    public:
+      /**
+       * @brief Default constructor.
+       */
+      Sat_solver();
+
+      /**
+       * @brief Destructor.
+       */
+      ~Sat_solver();
+
+      /**
+       * @brief Creates new variable.
+       *
+       * @return Variable number.
+       */
+      int
+      new_var();
+
+      /**
+       * @brief Gets variables number.
+       *
+       * @return Variables number.
+       */
+      size_t
+      get_vars_num() const;
+
+      /**
+       * @brief Adds clause.
+       *
+       * @param[in] clause Literals of clause.
+       *
+       * @return false if clauses became trivially unsatisfiable,
+       * @return true otherwise.
+       */
+      bool
+      add_clause(const std::vector<int>& clause);
+
+      /**
+       * @brief Checks satisfiability under assumptions.
+       *
+       * Learnt clauses are kept between calls.
+       *
+       * @param[in] assumps Assumed literals.
+       *
+       * @return true if clauses are satisfiable, false otherwise.
+       */
+      bool
+      solve(const std::vector<int>& assumps);
+
+      /**
+       * @brief Checks satisfiability.
+       *
+       * @return true if clauses are satisfiable, false otherwise.
+       */
+      bool
+      solve();
+
+      /**
+       * @brief Gets literal value in the model.
+       *
+       * @attention Must be called after successful solve method.
+       *
+       * @param[in] lit Literal.
+       *
+       * @return true if literal is true in the model, false otherwise.
+       */
+      bool
+      get_value(int lit) const;
+
+    private:
+      /**
+       * @brief Copying is prohibited.
+       */
+      Sat_solver(const Sat_solver&);
+
+      /**
+       * @brief Assignment is prohibited.
+       */
+      Sat_solver&
+      operator=(const Sat_solver&);
+
+    private:
+      /**
+       * @brief MiniSat solver.
+       */
+      MiniSat::Solver* solver;
+  }; // class Sat_solver
+}; // namespace mc_hybrid
+
+#endif // #ifndef SAT_SOLVER_HPP_
@@ -8,13 +8,19 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <cmath>
+#include <algorithm>
 
 #include "types.hpp"
 #include "variable.hpp"
 #include "constraint.hpp"
 #include "problem.hpp"
 #include "model_smv.hpp"
+#include "model_bdd.hpp"
+#include "model_cnf.hpp"
+#include "engine_bmc.hpp"
+#include "engine_kind.hpp"
+#include "engine_ic3.hpp"
+#include "nusmv_session.hpp"
 #include "counterexample.hpp"
 #include "solver.hpp"
 #include "parser.hpp"
@@ -29,9 +35,31 @@ using std::cout;
 using std::endl;
 using std::ostringstream;
 using std::vector;
+using std::swap;
 
 namespace mc_hybrid
 {
+  /**
+   * @brief Maximal range of discrete variable encoded by order encoding
+   * if automatic encoding is selected.
+   */
+  const size_t auto_order_range = 15;
+
+  /**
+   * @brief Prints thresholds tuned by minisat+.
+   *
+   * @param[in] tunings Reports of minisat+ runs.
+   */
+  static void
+  print_tunings(const vector<string>& tunings)
+  {
+    cout << "====================================" << endl;
+    cout << "= Tuned encoding thresholds        =" << endl;
+    cout << "====================================" << endl;
+    for (size_t i = 0; i < tunings.size(); ++i)
+      cout << tunings[i] << endl;
+  }
+
   Solver::Solver()
   {
     problem_original = 0;
@@ -41,6 +69,10 @@ namespace mc_hybrid
     problem_pb = 0;
 
     model_smv = 0;
+    model_bdd = 0;
+    model_cnf = 0;
+
+    nusmv_session = 0;
 
     counterexample_boolean = 0;
     counterexample_discrete = 0;
@@ -75,6 +107,18 @@ namespace mc_hybrid
       delete model_smv;
     model_smv = 0;
 
+    if (model_bdd)
+      delete model_bdd;
+    model_bdd = 0;
+
+    if (model_cnf)
+      delete model_cnf;
+    model_cnf = 0;
+
+    if (nusmv_session)
+      delete nusmv_session;
+    nusmv_session = 0;
+
     if (counterexample_boolean)
       delete counterexample_boolean;
     counterexample_boolean = 0;
@@ -89,11 +133,14 @@ namespace mc_hybrid
   }
 
   ulong_t
-  Solver::verify(const string& filename, int initial_q_param, int verbosity)
+  Solver::verify(const string& filename, const Options& options)
   {
     timeval time_start;
     gettimeofday(&time_start, NULL);
 
+    this->options = options;
+    int verbosity = options.verbosity;
+
     if (problem_original != 0)
       delete problem_original;
     problem_original = new Problem();
@@ -114,7 +161,7 @@ namespace mc_hybrid
     {
       Variable& v = problem_without_outputs->get_variable(i);
       if (v.get_type() == Variable::REAL)
-        q_params.insert(make_pair(v.get_name(), initial_q_param));
+        q_params.insert(make_pair(v.get_name(), options.q_param));
     }
     make_problem_quantized();
     if (verbosity > 0)
@@ -144,15 +191,43 @@ namespace mc_hybrid
     }
 
     make_model_smv();
-    if (verbosity > 0)
+    if (verbosity > 0 && model_smv != 0)
     {
       cout << "====================================" << endl;
       cout << "= SMV model                        =" << endl;
       cout << "====================================" << endl;
       cout << *model_smv;
     }
+    if (verbosity > 0 && options.tune > 0 && model_cnf != 0)
+      print_tunings(model_cnf->get_tunings());
+    if (verbosity > 0 && options.tune > 0 && model_smv != 0)
+      print_tunings(model_smv->tunings);
 
-    verify_model_smv();
+    bool result = verify_model_smv();
+    if (verbosity > 0)
+    {
+      cout << "====================================" << endl;
+      cout << "= Verification result              =" << endl;
+      cout << "====================================" << endl;
+      if (result && (options.engine == Options::ENGINE_BMC ||
+                     (options.engine == Options::ENGINE_NUSMV &&
+                      options.nusmv_algorithm == Options::NUSMV_BMC)))
+        cout << "No counterexample of length up to " << options.depth + 1 <<
+                " found." << endl;
+      else if (result)
+        cout << "Specification holds." << endl;
+      else
+      {
+        cout << "Specification doesn't hold";
+        if (counterexample_boolean != 0)
+          cout << ", counterexample length is " <<
+                  counterexample_boolean->get_steps_count();
+        cout << "." << endl;
+        if (options.approximate)
+          cout << "Counterexample may be spurious: real variables are " <<
+                  "eliminated approximately." << endl;
+      }
+    }
     //bool stop = false;
     //while (stop != true)
     //{
@@ -288,6 +363,7 @@ namespace mc_hybrid
         }
       }
     }
+    problem_quantized->canonicalize_constraints();
   }
 
   void
@@ -313,7 +389,12 @@ namespace mc_hybrid
       }
     }
 
-    // add constraints
+    // add constraints, they are added with coprime integer coefficients
+    if (options.approximate)
+    {
+      approximate_real_variables();
+      return;
+    }
     for (size_t i = 0; i < Problem::CONSTRS_GROUPS_TOTAL; ++i)
     {
       Problem::Constrs_group group = Problem::Constrs_group(i);
@@ -329,22 +410,64 @@ namespace mc_hybrid
                           real_vars_num,
                           problem_quantized,
                           problem_discrete);
-      for (size_t j = 0; j < problem_discrete->get_constraints_num(group); ++j)
+    }
+  }
+
+  void
+  Solver::approximate_real_variables()
+  {
+    for (size_t g = 0; g < Problem::CONSTRS_GROUPS_TOTAL; ++g)
+    {
+      Problem::Constrs_group group = Problem::Constrs_group(g);
+      bool spec = (group == Problem::CONSTRS_SPEC);
+      size_t vars_num = problem_quantized->get_constraints_vars_num(group);
+      for (size_t i = 0; i < problem_quantized->get_constraints_num(group); ++i)
       {
-        Constraint& c = problem_discrete->get_constraint(group, j);
-        vector<int_t> nums;
-        for (size_t k = 0; k < problem_discrete->get_constraints_vars_num(group); ++k)
+        Constraint& c = problem_quantized->get_constraint(group, i);
+        Constraint c_d(c.get_type());
+        bool has_reals = false;
+        // Least, greatest and lower bounds values of real terms sum.
+        real_t min_sum = 0;
+        real_t max_sum = 0;
+        real_t lower_sum = 0;
+        for (size_t j = 0; j < vars_num; ++j)
         {
-          Variable& v = problem_discrete->get_constraints_var(group, k);
+          Variable& v = problem_quantized->get_constraints_var(group, j);
           real_t coeff = c.get_coeff(v);
-          if (coeff != 0)
-            nums.push_back(coeff.get_den());
+          if (coeff == 0)
+            continue;
+          if (v.get_type() != Variable::REAL)
+          {
+            c_d.set_coeff(v, coeff);
+            continue;
+          }
+          has_reals = true;
+          real_t low = coeff * v.get_lower_bound();
+          real_t high = coeff * v.get_upper_bound();
+          lower_sum += low;
+          if (low > high)
+            swap(low, high);
+          min_sum += low;
+          max_sum += high;
         }
+
         real_t free_member = c.get_free_member();
-        if (free_member != 0)
-          nums.push_back(free_member.get_den());
-        int_t lcf_num = lcf(nums);
-        c.mult(lcf_num);
+        if (!has_reals)
+          c_d.set_free_member(free_member);
+        else if (c.get_type() == Constraint::MORE_OR_EQUAL)
+          c_d.set_free_member(free_member + (spec ? min_sum : max_sum));
+        else if (spec)
+          c_d.set_free_member(free_member + lower_sum);
+        else
+        {
+          // -max_sum <= sum of discrete terms + free_member <= -min_sum
+          c_d.set_type(Constraint::MORE_OR_EQUAL);
+          c_d.set_free_member(free_member + max_sum);
+          problem_discrete->add_constraint(group, c_d);
+          c_d.mult(-1);
+          c_d.set_free_member(-free_member - min_sum);
+        }
+        problem_discrete->add_constraint(group, c_d);
       }
     }
   }
@@ -362,6 +485,7 @@ namespace mc_hybrid
 
     // clear variables mapping
     vars_mapping.clear();
+    vars_encodings.clear();
 
     // add variables
     for (size_t i = 0, index = 0; i < Problem::VARS_GROUPS_TOTAL; ++i)
@@ -370,12 +494,17 @@ namespace mc_hybrid
       for (size_t j = 0; j < problem_discrete->get_variables_num(group); ++j)
       {
         Variable& v_d = problem_discrete->get_variable(group, j);
-        real_t lower_bound = v_d.get_lower_bound();
-        real_t upper_bound = v_d.get_upper_bound();
-        size_t num = size_t(floor(log(upper_bound.get_d() -
-                                      lower_bound.get_d()) /
-                                  log(2)) +
-                            1);
+        int_t range = get_range(v_d);
+        Options::Encoding encoding = get_encoding(v_d.get_name(), range);
+        size_t num;
+        if (encoding == Options::ENCODING_ORDER)
+          num = range.get_ui();
+        else if (encoding == Options::ENCODING_ONEHOT)
+          num = range.get_ui() + 1;
+        else
+          // Bit length of range, no bits for a constant.
+          num = range == 0 ? 0 : mpz_sizeinbase(range.get_mpz_t(), 2);
+        vars_encodings[v_d.get_name()] = encoding;
 
         for (size_t k = 0; k < num; ++k, ++index)
         {
@@ -414,10 +543,20 @@ namespace mc_hybrid
           real_t coeff = c_d.get_coeff(v_d);
           if (coeff != 0)
           {
+            Options::Encoding encoding = vars_encodings[v_d.get_name()];
             for (size_t w = 0; w < vars_mapping[v_d.get_name()].size(); ++w)
             {
               string& name = vars_mapping[v_d.get_name()][w];
-              c_b.set_coeff(name, coeff * pow(2.0f, w));
+              if (encoding == Options::ENCODING_ORDER)
+                c_b.set_coeff(name, coeff);
+              else if (encoding == Options::ENCODING_ONEHOT)
+              {
+                // Bit of the lower bound doesn't add anything.
+                if (w > 0)
+                  c_b.set_coeff(name, coeff * real_t(w));
+              }
+              else
+                c_b.set_coeff(name, coeff * int_t(int_t(1) << w));
             }
             free_member += coeff * v_d.get_lower_bound();
           }
@@ -427,6 +566,133 @@ namespace mc_hybrid
         problem_pb->add_constraint(group, c_b);
       }
     }
+
+    // add domain constraints, states are constrained by initial conditions
+    // and by transitional relation, inputs and next states by the latter
+    for (size_t i = 0; i < Problem::VARS_GROUPS_TOTAL; ++i)
+    {
+      Problem::Vars_group group = Problem::Vars_group(i);
+      for (size_t j = 0; j < problem_discrete->get_variables_num(group); ++j)
+      {
+        Variable& v_d = problem_discrete->get_variable(group, j);
+        add_domain_constraints(v_d.get_name(),
+                               get_range(v_d),
+                               group == Problem::VARS_STATE);
+      }
+    }
+  }
+
+  int_t
+  Solver::get_range(Variable& v) const
+  {
+    real_t range = v.get_upper_bound() - v.get_lower_bound();
+    if (range < 0)
+      return 0;
+    return range.get_num() / range.get_den();
+  }
+
+  Options::Encoding
+  Solver::get_encoding(const string& name, const int_t& range) const
+  {
+    string state_name = name;
+    if (!state_name.empty() && *(state_name.end() - 1) == '\'')
+      state_name.erase(state_name.end() - 1);
+
+    Options::Encoding encoding = options.encoding;
+    std::map<string, Options::Encoding>::const_iterator it =
+      options.vars_encodings.find(state_name);
+    if (it != options.vars_encodings.end())
+      encoding = it->second;
+
+    // Order encoding of small domain takes a few more bits than binary one,
+    // but all its bits have the same coefficient in every constraint, so
+    // BDDs and sorters of minisat+ stay small.
+    if (encoding == Options::ENCODING_AUTO)
+      encoding = range <= auto_order_range ? Options::ENCODING_ORDER :
+                                             Options::ENCODING_BINARY;
+    return encoding;
+  }
+
+  void
+  Solver::add_domain_constraints(const string& name,
+                                 const int_t& range,
+                                 bool state)
+  {
+    Options::Encoding encoding = vars_encodings[name];
+    vector<string>& bits = vars_mapping[name];
+    vector<Constraint> constrs;
+
+    if (encoding == Options::ENCODING_ORDER)
+    {
+      // bit[k] >= bit[k + 1]
+      for (size_t k = 0; k + 1 < bits.size(); ++k)
+      {
+        Constraint c(Constraint::MORE_OR_EQUAL);
+        c.set_coeff(bits[k], 1);
+        c.set_coeff(bits[k + 1], -1);
+        constrs.push_back(c);
+      }
+    }
+    else if (encoding == Options::ENCODING_ONEHOT)
+    {
+      // sum of bits == 1
+      Constraint c(Constraint::EQUAL);
+      for (size_t k = 0; k < bits.size(); ++k)
+        c.set_coeff(bits[k], 1);
+      c.set_free_member(-1);
+      constrs.push_back(c);
+    }
+    else
+    {
+      // Binary code doesn't exceed range lexicographically: for each zero
+      // bit of range, the code bit may be set only if some higher one bit of
+      // range is cleared in the code. Each such clause is a constraint
+      // "sum of (1 - bit) >= 1". Nothing is added if range is 2^n - 1.
+      for (size_t k = 0; k < bits.size(); ++k)
+      {
+        if (mpz_tstbit(range.get_mpz_t(), k))
+          continue;
+        Constraint c(Constraint::MORE_OR_EQUAL);
+        c.set_coeff(bits[k], -1);
+        int literals = 1;
+        for (size_t w = k + 1; w < bits.size(); ++w)
+          if (mpz_tstbit(range.get_mpz_t(), w))
+          {
+            c.set_coeff(bits[w], -1);
+            ++literals;
+          }
+        c.set_free_member(literals - 1);
+        constrs.push_back(c);
+      }
+    }
+
+    for (size_t i = 0; i < constrs.size(); ++i)
+    {
+      if (state)
+        problem_pb->add_constraint(Problem::CONSTRS_INIT, constrs[i]);
+      problem_pb->add_constraint(Problem::CONSTRS_TRANS, constrs[i]);
+    }
+  }
+
+  real_t
+  Solver::decode_value(const string& name,
+                       real_t lower_bound,
+                       const vector<real_t>& bits) const
+  {
+    Options::Encoding encoding = vars_encodings.find(name)->second;
+    real_t value = lower_bound;
+    for (size_t k = 0; k < bits.size(); ++k)
+    {
+      if (bits[k] == 0)
+        continue;
+      if (encoding == Options::ENCODING_ORDER)
+        value += 1;
+      else if (encoding == Options::ENCODING_ONEHOT)
+        value += real_t(k);
+      else
+        value += int_t(int_t(1) << k);
+    }
+    return value;
   }
 
   void
@@ -437,17 +703,83 @@ namespace mc_hybrid
 
     if (model_smv != 0)
       delete model_smv;
+    model_smv = 0;
 
-    model_smv = new Model_smv(*problem_pb);
+    if (model_bdd != 0)
+      delete model_bdd;
+    model_bdd = 0;
+
+    if (model_cnf != 0)
+      delete model_cnf;
+    model_cnf = 0;
+
+    if (options.engine == Options::ENGINE_BDD)
+      model_bdd = new Model_bdd(*problem_pb, options.backward);
+    else if (options.engine == Options::ENGINE_BMC ||
+             options.engine == Options::ENGINE_KIND ||
+             options.engine == Options::ENGINE_IC3)
+      model_cnf = new Model_cnf(*problem_pb, options);
+    else
+      model_smv = new Model_smv(*problem_pb, options);
   }
 
   bool
   Solver::verify_model_smv()
   {
+    if (model_bdd != 0)
+      return model_bdd->verify(counterexample_boolean);
+
+    if (model_cnf != 0 && options.engine == Options::ENGINE_BMC)
+    {
+      Engine_bmc engine(*model_cnf, options.depth);
+      return engine.verify(counterexample_boolean);
+    }
+
+    if (model_cnf != 0 && options.engine == Options::ENGINE_IC3)
+    {
+      Engine_ic3 engine(*model_cnf);
+      bool result = engine.verify(counterexample_boolean);
+      if (result && options.verbosity > 0)
+      {
+        cout << "====================================" << endl;
+        cout << "= Inductive invariant              =" << endl;
+        cout << "====================================" << endl;
+        engine.write_invariant(cout);
+        cout << endl;
+      }
+      return result;
+    }
+
+    if (model_cnf != 0)
+    {
+      Engine_kind engine(*model_cnf, options.depth);
+      Engine_kind::Result result = engine.verify(counterexample_boolean);
+      if (result != Engine_kind::RESULT_UNKNOWN)
+      {
+        if (options.verbosity > 0)
+          cout << "k-induction is conclusive at k = " << engine.get_k() << endl;
+        return result == Engine_kind::RESULT_HOLDS;
+      }
+
+      // Fall back to NuSMV.
+      if (options.verbosity > 0)
+        cout << "k-induction is inconclusive up to k = " << engine.get_k() <<
+                ", launching NuSMV" << endl;
+      if (model_smv == 0)
+      {
+        model_smv = new Model_smv(*problem_pb, options);
+        if (options.verbosity > 0 && options.tune > 0)
+          print_tunings(model_smv->tunings);
+      }
+    }
+
     if (model_smv == 0)
       throw logic_error("SMV model doesn't exist.");
 
-    return model_smv->verify(counterexample_boolean);
+    if (nusmv_session == 0)
+      nusmv_session = new Nusmv_session();
+
+    return model_smv->verify(*nusmv_session, counterexample_boolean);
   }
 
   bool
@@ -460,9 +792,30 @@ namespace mc_hybrid
       delete counterexample_discrete;
     counterexample_discrete = new Counterexample(*problem_discrete);
 
+    // Values of discrete variables are decoded from their bits.
     for (size_t i = 0; i < counterexample_boolean->get_steps_count(); ++i)
     {
       counterexample_discrete->add_step();
+      // Input and state variables.
+      for (size_t j = 0; j < Problem::VARS_NEXT_STATE; ++j)
+      {
+        Problem::Vars_group group = Problem::Vars_group(j);
+        for (size_t k = 0; k < problem_discrete->get_variables_num(group); ++k)
+        {
+          Variable& v = problem_discrete->get_variable(group, k);
+          vector<string>& names = vars_mapping[v.get_name()];
+          vector<real_t> bits;
+          for (size_t w = 0; w < names.size(); ++w)
+            bits.push_back(group == Problem::VARS_INPUT ?
+                           counterexample_boolean->get_ivar_value(i, names[w]) :
+                           counterexample_boolean->get_var_value(i, names[w]));
+          real_t value = decode_value(v.get_name(), v.get_lower_bound(), bits);
+          if (group == Problem::VARS_INPUT)
+            counterexample_discrete->set_ivar_value(i, v.get_name(), value);
+          else
+            counterexample_discrete->set_var_value(i, v.get_name(), value);
+        }
+      }
     }
 
     return false;
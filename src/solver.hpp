@@ -12,17 +12,25 @@
 #include <map>
 #include <string>
 
+#include "options.hpp"
+
 namespace mc_hybrid
 {
+  class Variable;
   class Problem;
   class Model_smv;
+  class Model_bdd;
+  class Model_cnf;
   class Counterexample;
+  class Nusmv_session;
 
   /**
    * @brief Application logic.
    *
    * @see Problem
    * @see Model_smv
+   * @see Model_bdd
+   * @see Model_cnf
    * @see Counterexample
    */
   class Solver
@@ -45,17 +53,16 @@ namespace mc_hybrid
       /**
        * @brief Verifies hybrid system.
        *
-       * Verifies given hybrid system with given initial quantization
-       * parameter value.
+       * Verifies given hybrid system with given options (initial
+       * quantization parameter value, model checking engine, etc.).
        *
-       * @param[in] filename        Path to the input file.
-       * @param[in] initial_q_param Initial value of quantization param.
-       * @param[in] verbosity       Verbosity value.
+       * @param[in] filename Path to the input file.
+       * @param[in] options  Verification options.
        *
        * @return Duration of verification process.
        */
       ulong_t
-      verify(const std::string& filename, int initial_q_param, int verbosity);
+      verify(const std::string& filename, const Options& options);
 
       /**
        * @brief Gets counterexample.
@@ -99,6 +106,22 @@ namespace mc_hybrid
       void
       make_problem_discrete();
 
+      /**
+       * @brief Makes discrete problem eliminating real variables by bounds.
+       *
+       * Each constraint is made into constraint without real variables,
+       * which is implied by it: sum of their terms is replaced by its
+       * greatest value over variables bounds (equation becomes two
+       * inequalities, with the greatest and the least value). Specification
+       * constraints take the least value instead (equation takes variables
+       * at lower bounds), so they aren't weakened. Time is linear in
+       * constraints size, but projection isn't exact: specification holding
+       * for discrete problem holds for the exact one, counterexample can be
+       * spurious.
+       */
+      void
+      approximate_real_variables();
+
       /**
        * @brief Makes pseudoboolean problem.
        *
@@ -108,10 +131,66 @@ namespace mc_hybrid
       void
       make_problem_pb();
 
+      /**
+       * @brief Gets range of discrete variable.
+       *
+       * @param[in] v %Variable.
+       *
+       * @return Difference of upper and lower bounds (exact).
+       */
+      int_t
+      get_range(Variable& v) const;
+
+      /**
+       * @brief Gets encoding of discrete variable by boolean ones.
+       *
+       * Next state variable has the encoding of its state variable.
+       *
+       * @param[in] name %Variable name.
+       * @param[in] range Difference of upper and lower bounds.
+       *
+       * @return Binary, order or one-hot encoding.
+       */
+      Options::Encoding
+      get_encoding(const std::string& name, const int_t& range) const;
+
+      /**
+       * @brief Adds domain constraints of discrete variable.
+       *
+       * Adds constraints to pseudoboolean problem, excluding values of
+       * boolean variables which encode no value of discrete variable:
+       * order encoding bits must be monotone, one-hot encoding has exactly
+       * one bit set, binary code doesn't exceed the range.
+       *
+       * @param[in] name  %Variable name.
+       * @param[in] range Difference of upper and lower bounds.
+       * @param[in] state true if variable is a state one, so its domain is
+       *                  constrained in initial states too.
+       */
+      void
+      add_domain_constraints(const std::string& name,
+                             const int_t& range,
+                             bool state);
+
+      /**
+       * @brief Decodes value of discrete variable.
+       *
+       * @param[in] name        %Variable name.
+       * @param[in] lower_bound Lower bound of variable.
+       * @param[in] bits        Values of boolean variables from vars_mapping.
+       *
+       * @return %Variable value.
+       */
+      real_t
+      decode_value(const std::string& name,
+                   real_t lower_bound,
+                   const std::vector<real_t>& bits) const;
+
       /**
        * @brief Makes SMV model.
        *
-       * Makes SMV model equivalent to pseudoboolean problem.
+       * Makes model equivalent to pseudoboolean problem: SMV model for NuSMV
+       * engine, OBDD model for BDD engine or CNF model for BMC engine.
        */
       void
       make_model_smv();
@@ -119,9 +198,11 @@ namespace mc_hybrid
       /**
        * @brief Verifies SMV model.
        *
-       * Verifies SMV model using NuSMV model checker.
+       * Verifies model using NuSMV model checker, in-process symbolic
+       * reachability or bounded model checking, depending on selected engine.
        *
-       * @return true if model fits specification, false otherwise.
+       * @return true if model fits specification (or if there is no
+       * @return counterexample up to maximal depth for BMC), false otherwise.
        */
       bool
       verify_model_smv();
@@ -156,6 +237,11 @@ namespace mc_hybrid
       change_q_params();
 
     private:
+      /**
+       * @brief Verification options.
+       */
+      Options options;
+
       /**
        * @brief Quantization parameters for real variables.
        */
@@ -186,11 +272,28 @@ namespace mc_hybrid
        * @brief Mapping between integer and boolean variables.
        */
       std::map<std::string, std::vector<std::string> > vars_mapping;
+      /**
+       * @brief Encodings of integer variables by boolean ones.
+       */
+      std::map<std::string, Options::Encoding> vars_encodings;
 
       /**
        * @brief SMV model.
        */
       Model_smv* model_smv;
+      /**
+       * @brief OBDD model.
+       */
+      Model_bdd* model_bdd;
+      /**
+       * @brief CNF model.
+       */
+      Model_cnf* model_cnf;
+
+      /**
+       * @brief NuSMV session shared by all SMV models.
+       */
+      Nusmv_session* nusmv_session;
 
       /**
        * @brief Counterexample for verification of boolean model.